@@ -1,9 +1,9 @@
 #include <iostream>
 #include <openssl/sha.h>
-#include <iomanip>
-#include <sstream>
 #include <string>
 
+#include "hex.hpp"
+
 std::string sha256(const std::string& input) {
     unsigned char hash[SHA256_DIGEST_LENGTH];
     SHA256_CTX sha256_ctx;
@@ -12,10 +12,9 @@ std::string sha256(const std::string& input) {
     SHA256_Update(&sha256_ctx, input.c_str(), input.size());
     SHA256_Final(hash, &sha256_ctx);
 
-    std::ostringstream oss;
-    for (int i = 0; i < SHA256_DIGEST_LENGTH; i++)
-        oss << std::hex << std::setw(2) << std::setfill('0') << (int)hash[i];
-    return oss.str();
+    char hex[2 * SHA256_DIGEST_LENGTH];
+    hex_encode(hash, SHA256_DIGEST_LENGTH, hex);
+    return std::string(hex, sizeof(hex));
 }
 
 int main() {
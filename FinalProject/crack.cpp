@@ -0,0 +1,80 @@
+// Command line front end for the CPU cracking engine.
+//
+//   crack [-j threads] -m MASK              target...
+//   crack [-j threads] -w WORDLIST [-r RULES] target...
+//
+// A target is a 32-digit hex MD5 digest or a file with one digest per line.
+// RULES is a file with one rule per line (see WordlistSpace).
+
+#include "crack.hpp"
+#include "hex.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static std::vector<std::string> read_lines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    for (std::string line; std::getline(in, line); ) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+template <typename Space>
+static int run(const Space& space, const std::vector<Digest>& targets, unsigned threads) {
+    CrackReport rep = crack(space, targets, threads);
+    {
+        HexWriter out(stdout);
+        for (const auto& f : rep.found) out.write(f.first).put(':').put(f.second).put('\n');
+    }
+    for (std::size_t t = 0; t < rep.thread_hashes.size(); ++t) {
+        std::fprintf(stderr, "thread %2zu: %12llu hashes %10.2f MH/s\n", t,
+                     (unsigned long long)rep.thread_hashes[t], rep.thread_hashes_per_s(t) / 1e6);
+    }
+    std::fprintf(stderr, "total: %llu hashes in %.3f s, %.2f MH/s, %zu/%zu found\n",
+                 (unsigned long long)rep.total_hashes, rep.seconds, rep.hashes_per_s() / 1e6,
+                 rep.found.size(), rep.num_targets);
+    return rep.found.size() == rep.num_targets ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned threads = 0;
+    std::string mask, wordlist, rules;
+    std::vector<Digest> targets;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-j" && i + 1 < argc)      threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else if (a == "-m" && i + 1 < argc) mask = argv[++i];
+        else if (a == "-w" && i + 1 < argc) wordlist = argv[++i];
+        else if (a == "-r" && i + 1 < argc) rules = argv[++i];
+        else {
+            Digest d;
+            if (a.size() == 32 && hex_decode(a.data(), 16, d.data())) { targets.push_back(d); continue; }
+            std::size_t bad = 0;
+            if (!load_hex_digests(a, targets, &bad)) {
+                std::cerr << "crack: cannot read " << a << "\n";
+                return 2;
+            }
+            if (bad) std::cerr << "crack: skipped " << bad << " malformed lines in " << a << "\n";
+        }
+    }
+    if (targets.empty() || mask.empty() == wordlist.empty()) {
+        std::cerr << "usage: crack [-j threads] (-m MASK | -w WORDLIST [-r RULES]) target...\n";
+        return 2;
+    }
+
+    try {
+        if (!mask.empty()) return run(MaskSpace(mask), targets, threads);
+        std::vector<std::string> r;
+        if (!rules.empty()) r = read_lines(rules);
+        return run(WordlistSpace(read_lines(wordlist), r), targets, threads);
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "crack: " << e.what() << "\n";
+        return 2;
+    }
+}
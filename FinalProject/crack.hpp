@@ -0,0 +1,273 @@
+// crack.hpp — public domain / CC0
+// CPU MD5 cracking engine. A keyspace (mask or wordlist x rules) is split
+// into one contiguous range per thread; threads take fixed-size chunks from
+// their own range and steal chunks from other ranges once theirs is empty.
+// Candidates are generated in place in per-thread buffers (no allocation per
+// candidate) and hashed MD5xN::digest_batch-wide. All threads stop as soon
+// as every target digest has been found.
+#pragma once
+
+#include "md5xn.hpp"
+#include "digest_set.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Digest = std::array<uint8_t, 16>;
+
+// Mask keyspace, hashcat syntax: ?l ?u ?d ?s ?a ?? or literal characters.
+// The last position varies fastest.
+class MaskSpace {
+public:
+    static constexpr std::size_t max_len = 64;
+
+    struct Cursor {
+        uint8_t digit[max_len];   // per-position index into its charset
+        char buf[max_len];        // current candidate
+        std::size_t len;
+    };
+
+    explicit MaskSpace(const std::string& mask) {
+        static const std::string lower = "abcdefghijklmnopqrstuvwxyz";
+        static const std::string upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+        static const std::string digit = "0123456789";
+        static const std::string special = " !\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~";
+
+        for (std::size_t i = 0; i < mask.size(); ++i) {
+            if (mask[i] != '?') { sets_.push_back(std::string(1, mask[i])); continue; }
+            if (++i == mask.size()) throw std::invalid_argument("mask ends with '?'");
+            switch (mask[i]) {
+                case 'l': sets_.push_back(lower); break;
+                case 'u': sets_.push_back(upper); break;
+                case 'd': sets_.push_back(digit); break;
+                case 's': sets_.push_back(special); break;
+                case 'a': sets_.push_back(lower + upper + digit + special); break;
+                case '?': sets_.push_back("?"); break;
+                default:  throw std::invalid_argument(std::string("unknown mask class ?") + mask[i]);
+            }
+        }
+        if (sets_.size() > max_len) throw std::invalid_argument("mask too long");
+
+        size_ = 1;
+        for (const auto& s : sets_) {
+            if (size_ > UINT64_MAX / s.size()) throw std::invalid_argument("mask keyspace overflows 64 bits");
+            size_ *= s.size();
+        }
+    }
+
+    uint64_t size() const { return size_; }
+
+    void seek(Cursor& c, uint64_t idx) const {
+        c.len = sets_.size();
+        for (std::size_t p = sets_.size(); p-- > 0; ) {
+            const std::string& s = sets_[p];
+            c.digit[p] = static_cast<uint8_t>(idx % s.size());
+            c.buf[p] = s[c.digit[p]];
+            idx /= s.size();
+        }
+    }
+
+    // Odometer increment: usually touches only the last character
+    void advance(Cursor& c) const {
+        for (std::size_t p = sets_.size(); p-- > 0; ) {
+            const std::string& s = sets_[p];
+            if (++c.digit[p] < s.size()) { c.buf[p] = s[c.digit[p]]; return; }
+            c.digit[p] = 0;
+            c.buf[p] = s[0];
+        }
+    }
+
+private:
+    std::vector<std::string> sets_;
+    uint64_t size_;
+};
+
+// Wordlist keyspace with hashcat-style mangling rules applied per word.
+// Supported rule functions: ':' noop, 'l' lower, 'u' upper, 'c' capitalize,
+// 'r' reverse, 'd' duplicate, '$X' append X, '^X' prepend X.
+// The rule varies fastest.
+class WordlistSpace {
+public:
+    static constexpr std::size_t max_len = 256;
+
+    struct Cursor {
+        uint64_t word, rule;
+        char buf[max_len];
+        std::size_t len;
+    };
+
+    WordlistSpace(const std::vector<std::string>& words, std::vector<std::string> rules = {":"})
+        : rules_(std::move(rules)) {
+        if (rules_.empty()) rules_.push_back(":");
+        for (const auto& w : words) {
+            offsets_.push_back(text_.size());
+            text_ += w.substr(0, max_len / 2);
+        }
+        offsets_.push_back(text_.size());
+    }
+
+    uint64_t size() const { return (offsets_.size() - 1) * rules_.size(); }
+
+    void seek(Cursor& c, uint64_t idx) const {
+        c.word = idx / rules_.size();
+        c.rule = idx % rules_.size();
+        apply(c);
+    }
+
+    void advance(Cursor& c) const {
+        if (++c.rule == rules_.size()) {
+            c.rule = 0;
+            if (++c.word == offsets_.size() - 1) return;   // past the end
+        }
+        apply(c);
+    }
+
+private:
+    void apply(Cursor& c) const {
+        std::size_t off = offsets_[c.word];
+        c.len = offsets_[c.word + 1] - off;
+        std::memcpy(c.buf, text_.data() + off, c.len);
+
+        const std::string& r = rules_[c.rule];
+        for (std::size_t i = 0; i < r.size(); ++i) {
+            switch (r[i]) {
+                case 'l': for (std::size_t k = 0; k < c.len; ++k) c.buf[k] = lower(c.buf[k]); break;
+                case 'u': for (std::size_t k = 0; k < c.len; ++k) c.buf[k] = upper(c.buf[k]); break;
+                case 'c':
+                    for (std::size_t k = 0; k < c.len; ++k) c.buf[k] = lower(c.buf[k]);
+                    if (c.len) c.buf[0] = upper(c.buf[0]);
+                    break;
+                case 'r': std::reverse(c.buf, c.buf + c.len); break;
+                case 'd':
+                    if (2 * c.len <= max_len) { std::memcpy(c.buf + c.len, c.buf, c.len); c.len *= 2; }
+                    break;
+                case '$':
+                    if (i + 1 < r.size() && c.len < max_len) c.buf[c.len++] = r[++i];
+                    break;
+                case '^':
+                    if (i + 1 < r.size() && c.len < max_len) {
+                        std::memmove(c.buf + 1, c.buf, c.len++);
+                        c.buf[0] = r[++i];
+                    }
+                    break;
+                default: break;   // ':' and whitespace
+            }
+        }
+    }
+
+    static char lower(char ch) { return (ch >= 'A' && ch <= 'Z') ? ch + 32 : ch; }
+    static char upper(char ch) { return (ch >= 'a' && ch <= 'z') ? ch - 32 : ch; }
+
+    std::string text_;                  // all words back to back
+    std::vector<std::size_t> offsets_;  // word i is text_[offsets_[i], offsets_[i+1])
+    std::vector<std::string> rules_;
+};
+
+struct CrackReport {
+    std::vector<std::pair<Digest, std::string>> found;
+    std::size_t num_targets = 0;   // distinct target digests
+    std::vector<uint64_t> thread_hashes;
+    std::vector<double> thread_seconds;
+    uint64_t total_hashes = 0;
+    double seconds = 0;
+
+    double hashes_per_s() const { return seconds > 0 ? total_hashes / seconds : 0.0; }
+    double thread_hashes_per_s(std::size_t t) const {
+        return thread_seconds[t] > 0 ? thread_hashes[t] / thread_seconds[t] : 0.0;
+    }
+};
+
+// Search space for any of the target digests using the given number of
+// threads (0 = hardware concurrency). chunk is the number of candidates a
+// thread claims at a time from its own or a victim's range.
+template <typename Space>
+CrackReport crack(const Space& space, const std::vector<Digest>& targets, unsigned threads = 0,
+                  uint64_t chunk = 1u << 14) {
+    const DigestSet<16> set(targets);
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+
+    struct alignas(64) Range {
+        std::atomic<uint64_t> next{0};
+        uint64_t end = 0;
+    };
+    std::vector<Range> ranges(threads);
+    const uint64_t total = space.size();
+    for (unsigned t = 0; t < threads; ++t) {
+        ranges[t].next = total / threads * t;
+        ranges[t].end = (t + 1 == threads) ? total : total / threads * (t + 1);
+    }
+
+    CrackReport rep;
+    rep.num_targets = set.size();
+    rep.thread_hashes.assign(threads, 0);
+    rep.thread_seconds.assign(threads, 0);
+    std::vector<char> found_flag(set.capacity(), 0);
+    std::atomic<std::size_t> remaining{set.size()};
+    std::mutex found_mtx;
+
+    auto worker = [&](unsigned t) {
+        constexpr std::size_t B = 16;   // candidates per digest_batch call
+        typename Space::Cursor cur;
+        char slots[B][Space::max_len];
+        const uint8_t* ptrs[B];
+        std::size_t lens[B];
+        Digest out[B];
+        for (std::size_t i = 0; i < B; ++i) ptrs[i] = reinterpret_cast<const uint8_t*>(slots[i]);
+
+        auto t0 = std::chrono::steady_clock::now();
+        uint64_t hashes = 0;
+
+        // own range first, then victims in ring order
+        for (unsigned v = 0; v < threads && remaining.load(std::memory_order_relaxed) > 0; ++v) {
+            Range& r = ranges[(t + v) % threads];
+            for (;;) {
+                if (remaining.load(std::memory_order_relaxed) == 0) break;
+                uint64_t b = r.next.fetch_add(chunk, std::memory_order_relaxed);
+                if (b >= r.end) break;
+                uint64_t e = std::min(b + chunk, r.end);
+
+                space.seek(cur, b);
+                for (uint64_t i = b; i < e; ) {
+                    std::size_t n = static_cast<std::size_t>(std::min<uint64_t>(B, e - i));
+                    for (std::size_t k = 0; k < n; ++k) {
+                        std::memcpy(slots[k], cur.buf, cur.len);
+                        lens[k] = cur.len;
+                        space.advance(cur);
+                    }
+                    MD5xN::digest_batch(ptrs, lens, n, out);
+                    for (std::size_t k = 0; k < n; ++k) {
+                        std::size_t idx = set.find(out[k]);
+                        if (idx == DigestSet<16>::npos) continue;
+                        std::lock_guard<std::mutex> lock(found_mtx);
+                        if (found_flag[idx]) continue;
+                        found_flag[idx] = 1;
+                        rep.found.emplace_back(out[k], std::string(slots[k], lens[k]));
+                        remaining.fetch_sub(1, std::memory_order_relaxed);
+                    }
+                    i += n;
+                    hashes += n;
+                }
+            }
+        }
+
+        rep.thread_hashes[t] = hashes;
+        rep.thread_seconds[t] = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker, t);
+    worker(0);
+    for (auto& th : pool) th.join();
+    rep.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    for (auto h : rep.thread_hashes) rep.total_hashes += h;
+    return rep;
+}
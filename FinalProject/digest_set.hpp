@@ -0,0 +1,121 @@
+// digest_set.hpp — public domain / CC0
+// Read-only lookup structure for millions of target digests. Digests are
+// already uniformly distributed, so their leading bytes serve directly as
+// the hash:
+//   - an open-addressing table with linear probing over 8-byte tags (the
+//     first 8 digest bytes), kept separate from the full digests so a probe
+//     scans 8 tags per cache line and only touches the digest on a tag hit;
+//   - an optional blocked Bloom filter in front (one 64-byte block per key,
+//     6 bits set per key) that rejects most misses with one cache line.
+// Nothing is mutated after construction, so any number of threads may probe
+// concurrently without locks.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+template <std::size_t N = 16>
+class DigestSet {
+    static_assert(N >= 16, "tags and Bloom hashes use the first 16 bytes");
+
+public:
+    using digest_type = std::array<uint8_t, N>;
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    // bloom: put a Bloom filter in front of the table (worth it once the
+    // table no longer fits in the last-level cache)
+    explicit DigestSet(const std::vector<digest_type>& targets, bool bloom = true) {
+        std::size_t cap = 16;
+        while (cap < 2 * targets.size()) cap <<= 1;   // load factor <= 0.5
+        mask_ = cap - 1;
+        tags_.assign(cap, 0);
+        keys_.resize(cap);
+
+        for (const auto& d : targets) {
+            uint64_t t = tag(d);
+            std::size_t i = t & mask_;
+            for (; tags_[i] != 0; i = (i + 1) & mask_) {
+                if (tags_[i] == t && keys_[i] == d) break;   // duplicate
+            }
+            if (tags_[i] == 0) { tags_[i] = t; keys_[i] = d; ++size_; }
+        }
+
+        if (bloom && size_ > 0) {
+            std::size_t blocks = 1;
+            // ~12 bits per key keeps the false-positive rate around 0.5%
+            while (blocks * 512 < size_ * 12) blocks <<= 1;
+            bloom_.assign(blocks, BloomBlock{});
+            bloom_mask_ = blocks - 1;
+            for (std::size_t i = 0; i < cap; ++i) {
+                if (tags_[i] != 0) bloom_add(keys_[i]);
+            }
+        }
+    }
+
+    // Slot of d in [0, capacity()), or npos. Slots are stable for the
+    // lifetime of the set, so callers can keep per-target state by slot.
+    std::size_t find(const digest_type& d) const {
+        if (!bloom_.empty() && !bloom_may_contain(d)) return npos;
+        uint64_t t = tag(d);
+        for (std::size_t i = t & mask_; tags_[i] != 0; i = (i + 1) & mask_) {
+            if (tags_[i] == t && keys_[i] == d) return i;
+        }
+        return npos;
+    }
+
+    bool contains(const digest_type& d) const { return find(d) != npos; }
+
+    const digest_type& at(std::size_t slot) const { return keys_[slot]; }
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return mask_ + 1; }
+    bool has_bloom() const { return !bloom_.empty(); }
+
+    std::size_t memory_bytes() const {
+        return tags_.capacity() * sizeof(uint64_t)
+             + keys_.capacity() * sizeof(digest_type)
+             + bloom_.capacity() * sizeof(BloomBlock);
+    }
+
+private:
+    struct alignas(64) BloomBlock { uint64_t w[8]; };
+
+    static uint64_t load64(const uint8_t* p) {
+        uint64_t v;
+        std::memcpy(&v, p, 8);
+        return v;
+    }
+
+    // never 0, which marks an empty slot
+    static uint64_t tag(const digest_type& d) {
+        uint64_t t = load64(d.data());
+        return t ? t : 1;
+    }
+
+    // block from bytes 8..15, six 9-bit positions from bytes 0..7
+    void bloom_add(const digest_type& d) {
+        uint64_t* blk = bloom_[load64(d.data() + 8) & bloom_mask_].w;
+        uint64_t h = load64(d.data());
+        for (int k = 0; k < 6; ++k, h >>= 9) blk[(h >> 6) & 7] |= 1ULL << (h & 63);
+    }
+
+    bool bloom_may_contain(const digest_type& d) const {
+        const uint64_t* blk = bloom_[load64(d.data() + 8) & bloom_mask_].w;
+        uint64_t h = load64(d.data());
+        for (int k = 0; k < 6; ++k, h >>= 9) {
+            if (!(blk[(h >> 6) & 7] & (1ULL << (h & 63)))) return false;
+        }
+        return true;
+    }
+
+    std::size_t mask_ = 0;
+    std::size_t size_ = 0;
+    std::vector<uint64_t> tags_;
+    std::vector<digest_type> keys_;
+    std::vector<BloomBlock> bloom_;
+    std::size_t bloom_mask_ = 0;
+};
@@ -0,0 +1,69 @@
+// Probe throughput and memory footprint of DigestSet for large target
+// lists, with and without the Bloom front, from 1..T threads.
+//
+//   digest_set_bench [targets] [max_threads]
+
+#include "digest_set.hpp"
+#include "md5.cpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using Digest = std::array<uint8_t, 16>;
+
+static std::vector<Digest> make_digests(std::size_t n, uint64_t seed) {
+    std::vector<Digest> v(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        uint64_t x[2] = {seed, i};
+        v[i] = MD5::digest(x, sizeof(x));
+    }
+    return v;
+}
+
+// Probe every digest in queries from each of `threads` threads; returns probes/s
+static double probe_rate(const DigestSet<16>& set, const std::vector<Digest>& queries, unsigned threads,
+                         std::size_t& hits) {
+    std::atomic<std::size_t> total_hits{0};
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            std::size_t h = 0;
+            for (std::size_t i = t; i < queries.size(); i += threads) h += set.contains(queries[i]);
+            total_hits += h;
+        });
+    }
+    for (auto& th : pool) th.join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    hits = total_hits;
+    return queries.size() / sec;
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t n = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned max_threads = (argc > 2) ? std::strtoul(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+
+    auto targets = make_digests(n, 1);
+    auto misses = make_digests(n, 2);
+
+    for (bool bloom : {false, true}) {
+        auto t0 = std::chrono::steady_clock::now();
+        DigestSet<16> set(targets, bloom);
+        double build = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::printf("bloom=%d  targets=%zu  memory=%.1f MiB (%.1f B/target)  build=%.3f s\n", bloom,
+                    set.size(), set.memory_bytes() / 1048576.0, (double)set.memory_bytes() / set.size(), build);
+
+        for (unsigned t = 1; t <= max_threads; t *= 2) {
+            std::size_t hit_count = 0, miss_hits = 0;
+            double hit_rate = probe_rate(set, targets, t, hit_count);
+            double miss_rate = probe_rate(set, misses, t, miss_hits);
+            std::printf("  threads=%2u  hits %7.1f Mprobe/s (%zu found)  misses %7.1f Mprobe/s (%zu false)\n",
+                        t, hit_rate / 1e6, hit_count, miss_rate / 1e6, miss_hits);
+        }
+    }
+    return 0;
+}
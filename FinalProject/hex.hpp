@@ -0,0 +1,227 @@
+// hex.hpp — public domain / CC0
+// Allocation-free hex formatting and parsing for digests. Encoding and
+// decoding work on caller-provided buffers, 16 bytes per step with SSSE3
+// (pshufb nibble lookup) when the CPU has it and a table-driven scalar path
+// otherwise. HexWriter streams formatted digests through one fixed buffer,
+// and parse_hex_digests / load_hex_digests turn target lists back into binary
+// digests in bulk.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace hex_detail {
+
+inline const char* digits() { return "0123456789abcdef"; }
+
+// ASCII -> nibble, 0xFF for anything that is not a hex digit
+struct DecodeTable {
+    uint8_t v[256];
+    DecodeTable() {
+        std::memset(v, 0xFF, sizeof(v));
+        for (int i = 0; i < 10; ++i) v['0' + i] = static_cast<uint8_t>(i);
+        for (int i = 0; i < 6; ++i) {
+            v['a' + i] = static_cast<uint8_t>(10 + i);
+            v['A' + i] = static_cast<uint8_t>(10 + i);
+        }
+    }
+};
+inline const DecodeTable& decode_table() { static const DecodeTable t; return t; }
+
+inline void encode_scalar(const uint8_t* in, std::size_t n, char* out) {
+    const char* d = digits();
+    for (std::size_t i = 0; i < n; ++i) {
+        out[2*i]   = d[in[i] >> 4];
+        out[2*i+1] = d[in[i] & 0xF];
+    }
+}
+
+inline bool decode_scalar(const char* in, std::size_t n, uint8_t* out) {
+    const uint8_t* t = decode_table().v;
+    uint8_t bad = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        uint8_t hi = t[static_cast<uint8_t>(in[2*i])];
+        uint8_t lo = t[static_cast<uint8_t>(in[2*i+1])];
+        bad |= (hi | lo) & 0xF0;
+        out[i] = static_cast<uint8_t>((hi << 4) | (lo & 0xF));
+    }
+    return bad == 0;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("ssse3")))
+inline void encode_ssse3(const uint8_t* in, std::size_t n, char* out) {
+    const __m128i lut = _mm_setr_epi8('0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f');
+    const __m128i mask = _mm_set1_epi8(0x0F);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(v, mask));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*i),      _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2*i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    encode_scalar(in + i, n - i, out + 2*i);
+}
+
+// 32 hex characters -> 16 bytes per step; any non-hex character fails
+__attribute__((target("ssse3")))
+inline bool decode_ssse3(const char* in, std::size_t n, uint8_t* out) {
+    auto nibbles = [](__m128i c, __m128i& valid) {
+        __m128i lower  = _mm_or_si128(c, _mm_set1_epi8(0x20));
+        __m128i is_dig = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                       _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+        __m128i is_hex = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                       _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+        valid = _mm_and_si128(valid, _mm_or_si128(is_dig, is_hex));
+        return _mm_or_si128(_mm_and_si128(is_dig, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                            _mm_and_si128(is_hex, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+    };
+    const __m128i weights = _mm_set1_epi16(0x0110);   // bytes {16, 1}: hi*16 + lo
+    __m128i valid = _mm_set1_epi8(-1);
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i a = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2*i)), valid);
+        __m128i b = nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2*i + 16)), valid);
+        __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), bytes);
+    }
+    bool ok = _mm_movemask_epi8(valid) == 0xFFFF;
+    return decode_scalar(in + 2*i, n - i, out + i) && ok;
+}
+#endif
+
+inline bool has_ssse3() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    static const bool yes = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3"));
+    return yes;
+#else
+    return false;
+#endif
+}
+
+} // namespace hex_detail
+
+// Write 2*n lowercase hex characters for in[0, n) to out (no terminator)
+inline void hex_encode(const uint8_t* in, std::size_t n, char* out) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (hex_detail::has_ssse3()) { hex_detail::encode_ssse3(in, n, out); return; }
+#endif
+    hex_detail::encode_scalar(in, n, out);
+}
+
+// Parse 2*n hex characters (either case) into n bytes; false on a bad digit
+inline bool hex_decode(const char* in, std::size_t n, uint8_t* out) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (hex_detail::has_ssse3()) return hex_detail::decode_ssse3(in, n, out);
+#endif
+    return hex_detail::decode_scalar(in, n, out);
+}
+
+// Format n digests as "hex<sep>" records into out, which must hold
+// n * (2*N + 1) bytes. Returns the number of bytes written.
+template <std::size_t N>
+inline std::size_t hex_encode_batch(const std::array<uint8_t, N>* d, std::size_t n, char* out,
+                                    char sep = '\n') {
+    char* p = out;
+    for (std::size_t i = 0; i < n; ++i) {
+        hex_encode(d[i].data(), N, p);
+        p[2*N] = sep;
+        p += 2*N + 1;
+    }
+    return static_cast<std::size_t>(p - out);
+}
+
+// Buffered writer for hex digests and the text around them (paths,
+// separators, plaintexts); nothing is allocated per record and the FILE is
+// only touched when the fixed buffer fills up.
+class HexWriter {
+public:
+    explicit HexWriter(std::FILE* f) : f_(f) {}
+    ~HexWriter() { flush(); }
+    HexWriter(const HexWriter&) = delete;
+    HexWriter& operator=(const HexWriter&) = delete;
+
+    template <std::size_t N>
+    HexWriter& write(const std::array<uint8_t, N>& d) {
+        static_assert(2*N <= sizeof(buf_), "digest too large for HexWriter");
+        if (len_ + 2*N > sizeof(buf_)) flush();
+        hex_encode(d.data(), N, buf_ + len_);
+        len_ += 2*N;
+        return *this;
+    }
+
+    HexWriter& put(const char* s, std::size_t n) {
+        while (n > 0) {
+            if (len_ == sizeof(buf_)) flush();
+            std::size_t k = std::min(n, sizeof(buf_) - len_);
+            std::memcpy(buf_ + len_, s, k);
+            len_ += k; s += k; n -= k;
+        }
+        return *this;
+    }
+    HexWriter& put(const std::string& s) { return put(s.data(), s.size()); }
+    HexWriter& put(char c) { return put(&c, 1); }
+
+    void flush() {
+        if (len_ > 0) std::fwrite(buf_, 1, len_, f_);
+        len_ = 0;
+    }
+
+private:
+    std::FILE* f_;
+    std::size_t len_ = 0;
+    char buf_[1 << 16];
+};
+
+// Parse one digest per line from text (md5sum-style lines are fine: only
+// the leading 2*N characters are used; blank lines are skipped). Appends to
+// out and returns the number of malformed lines.
+template <std::size_t N>
+inline std::size_t parse_hex_digests(const char* text, std::size_t len,
+                                     std::vector<std::array<uint8_t, N>>& out) {
+    std::size_t bad = 0;
+    const char* p = text;
+    const char* end = text + len;
+    out.reserve(out.size() + len / (2*N + 1));
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+        const char* eol = nl ? nl : end;
+        std::size_t n = static_cast<std::size_t>(eol - p);
+        if (n > 0 && p[n - 1] == '\r') --n;
+        if (n > 0) {
+            out.emplace_back();
+            bool ok = n >= 2*N && (n == 2*N || p[2*N] == ' ' || p[2*N] == '\t' || p[2*N] == ':')
+                   && hex_decode(p, N, out.back().data());
+            if (!ok) { out.pop_back(); ++bad; }
+        }
+        p = eol + 1;
+    }
+    return bad;
+}
+
+// Read a whole target file in one go and parse it. Returns false if the file
+// cannot be read; malformed lines are counted in *bad when given.
+template <std::size_t N>
+inline bool load_hex_digests(const std::string& path, std::vector<std::array<uint8_t, N>>& out,
+                             std::size_t* bad = nullptr) {
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return false;
+    std::string text;
+    char chunk[1 << 16];
+    for (std::size_t got; (got = std::fread(chunk, 1, sizeof(chunk), f)) > 0; ) text.append(chunk, got);
+    std::fclose(f);
+    std::size_t b = parse_hex_digests(text.data(), text.size(), out);
+    if (bad) *bad = b;
+    return true;
+}
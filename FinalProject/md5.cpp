@@ -1,16 +1,150 @@
 // md5.hpp — public domain / CC0
 // Pure C++17 implementation of MD5 (RFC 1321) with incremental API.
+#ifndef MD5_HPP
+#define MD5_HPP
 
 #include <cstdint>
 #include <cstddef>
 #include <array>
 #include <string>
 #include <cstring>
+#include <utility>
+
+// Round tables and byte helpers shared by MD5 and the batched variants.
+namespace md5_detail {
+
+// Per-round shift amounts
+inline constexpr uint32_t S[64] = {
+    7,12,17,22, 7,12,17,22, 7,12,17,22, 7,12,17,22,
+    5, 9,14,20, 5, 9,14,20, 5, 9,14,20, 5, 9,14,20,
+    4,11,16,23, 4,11,16,23, 4,11,16,23, 4,11,16,23,
+    6,10,15,21, 6,10,15,21, 6,10,15,21, 6,10,15,21
+};
+
+// Constants K[i] = floor(2^32 * abs(sin(i+1)))
+inline constexpr uint32_t K[64] = {
+    0xd76aa478u,0xe8c7b756u,0x242070dbu,0xc1bdceeeu,0xf57c0fafu,0x4787c62au,0xa8304613u,0xfd469501u,
+    0x698098d8u,0x8b44f7afu,0xffff5bb1u,0x895cd7beu,0x6b901122u,0xfd987193u,0xa679438eu,0x49b40821u,
+    0xf61e2562u,0xc040b340u,0x265e5a51u,0xe9b6c7aau,0xd62f105du,0x02441453u,0xd8a1e681u,0xe7d3fbc8u,
+    0x21e1cde6u,0xc33707d6u,0xf4d50d87u,0x455a14edu,0xa9e3e905u,0xfcefa3f8u,0x676f02d9u,0x8d2a4c8au,
+    0xfffa3942u,0x8771f681u,0x6d9d6122u,0xfde5380cu,0xa4beea44u,0x4bdecfa9u,0xf6bb4b60u,0xbebfbc70u,
+    0x289b7ec6u,0xeaa127fau,0xd4ef3085u,0x04881d05u,0xd9d4d039u,0xe6db99e5u,0x1fa27cf8u,0xc4ac5665u,
+    0xf4292244u,0x432aff97u,0xab9423a7u,0xfc93a039u,0x655b59c3u,0x8f0ccc92u,0xffeff47du,0x85845dd1u,
+    0x6fa87e4fu,0xfe2ce6e0u,0xa3014314u,0x4e0811a1u,0xf7537e82u,0xbd3af235u,0x2ad7d2bbu,0xeb86d391u
+};
+
+inline uint32_t read_le32(const uint8_t* p) {
+    return (uint32_t)p[0]
+         | ((uint32_t)p[1] << 8)
+         | ((uint32_t)p[2] << 16)
+         | ((uint32_t)p[3] << 24);
+}
+inline void write_le32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)(v & 0xFFu);
+    p[1] = (uint8_t)((v >> 8) & 0xFFu);
+    p[2] = (uint8_t)((v >> 16) & 0xFFu);
+    p[3] = (uint8_t)((v >> 24) & 0xFFu);
+}
+
+// Reference transform: table-driven 64-round loop, kept for clarity and
+// as the baseline the unrolled version is checked and benchmarked against.
+inline void compress_reference(uint32_t st[4], const uint8_t block[64]) {
+    uint32_t M[16];
+    for (int i = 0; i < 16; ++i) {
+        M[i] = read_le32(block + 4*i);
+    }
+
+    uint32_t A = st[0], B = st[1], C = st[2], D = st[3];
+
+    auto F = [](uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (~x & z); };
+    auto G = [](uint32_t x, uint32_t y, uint32_t z) { return (x & z) | (y & ~z); };
+    auto H = [](uint32_t x, uint32_t y, uint32_t z) { return x ^ y ^ z; };
+    auto I = [](uint32_t x, uint32_t y, uint32_t z) { return y ^ (x | ~z); };
+
+    auto rotl = [](uint32_t v, uint32_t s) { return (v << s) | (v >> (32 - s)); };
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        uint32_t f, g;
+        if (i < 16)       { f = F(B, C, D); g = i; }
+        else if (i < 32)  { f = G(B, C, D); g = (5*i + 1) & 15u; }
+        else if (i < 48)  { f = H(B, C, D); g = (3*i + 5) & 15u; }
+        else              { f = I(B, C, D); g = (7*i)      & 15u; }
+
+        uint32_t tmp = D;
+        D = C;
+        C = B;
+        uint32_t sum = A + f + K[i] + M[g];
+        B = B + rotl(sum, S[i]);
+        A = tmp;
+    }
+
+    st[0] += A; st[1] += B; st[2] += C; st[3] += D;
+}
+
+// Message word used by round i
+constexpr uint32_t msg_index(uint32_t i) {
+    return (i < 16) ? i
+         : (i < 32) ? (5*i + 1) & 15u
+         : (i < 48) ? (3*i + 5) & 15u
+         :            (7*i)      & 15u;
+}
+
+// One fully specialized round: function, message word, shift and constant
+// are all template constants, and the a/b/c/d role rotation is resolved
+// at compile time by indexing v[] with constants instead of moving values.
+template <uint32_t I>
+inline void round_step(uint32_t (&v)[4], const uint32_t (&M)[16]) {
+    constexpr uint32_t r = I & 3u;
+    uint32_t& a = v[(4 - r) & 3u];
+    const uint32_t b = v[(5 - r) & 3u];
+    const uint32_t c = v[(6 - r) & 3u];
+    const uint32_t d = v[(7 - r) & 3u];
+
+    uint32_t f;
+    if constexpr (I < 16)      f = d ^ (b & (c ^ d));
+    else if constexpr (I < 32) f = c ^ (d & (b ^ c));
+    else if constexpr (I < 48) f = b ^ c ^ d;
+    else                       f = c ^ (b | ~d);
+
+    constexpr uint32_t s = S[I];
+    uint32_t sum = a + f + K[I] + M[msg_index(I)];
+    a = b + ((sum << s) | (sum >> (32 - s)));
+}
+
+template <std::size_t... Is>
+inline void compress_rounds(uint32_t (&v)[4], const uint32_t (&M)[16],
+                            std::index_sequence<Is...>) {
+    (round_step<static_cast<uint32_t>(Is)>(v, M), ...);
+}
+
+// Unrolled transform: the 64 rounds are generated from an index sequence,
+// leaving straight-line code with immediate operands and no branches.
+inline void compress_unrolled(uint32_t st[4], const uint8_t block[64]) {
+    uint32_t M[16];
+    for (int i = 0; i < 16; ++i) {
+        M[i] = read_le32(block + 4*i);
+    }
+
+    uint32_t v[4] = {st[0], st[1], st[2], st[3]};
+    compress_rounds(v, M, std::make_index_sequence<64>{});
+    st[0] += v[0]; st[1] += v[1]; st[2] += v[2]; st[3] += v[3];
+}
+
+} // namespace md5_detail
 
 class MD5 {
 public:
+    // Chaining state after a 64-byte-aligned prefix; see snapshot()
+    struct State {
+        uint32_t a, b, c, d;
+        uint64_t prefix_len;    // bytes already absorbed (multiple of 64)
+    };
+
     MD5() { reset(); }
 
+    // Resume hashing after a prefix captured with snapshot()
+    explicit MD5(const State& st) { restore(st); }
+
     // Reset to initial state (allows reuse of the same object)
     void reset() {
         // Initialization constants (RFC 1321)
@@ -22,6 +156,21 @@ public:
         buffer_len_ = 0;
     }
 
+    // Capture the state after a prefix whose length is a multiple of 64, so
+    // many suffixes can be hashed without re-absorbing the prefix.
+    // Returns false (and leaves st untouched) if input is still buffered.
+    bool snapshot(State& st) const {
+        if (buffer_len_ != 0) return false;
+        st = State{a_, b_, c_, d_, total_len_};
+        return true;
+    }
+
+    void restore(const State& st) {
+        a_ = st.a; b_ = st.b; c_ = st.c; d_ = st.d;
+        total_len_ = st.prefix_len;
+        buffer_len_ = 0;
+    }
+
     // Feed arbitrary bytes
     void update(const void* data, std::size_t len) {
         const uint8_t* p = static_cast<const uint8_t*>(data);
@@ -65,7 +214,7 @@ public:
         pad[pad_len++] = 0x80;
 
         std::size_t cur_mod = (buffer_len_) % 64;
-        std::size_t need_zeroes = (cur_mod <= 56) ? (56 - cur_mod) : (56 + 64 - cur_mod);
+        std::size_t need_zeroes = (cur_mod < 56) ? (55 - cur_mod) : (55 + 64 - cur_mod);
         std::memset(pad + pad_len, 0, need_zeroes);
         pad_len += need_zeroes;
 
@@ -79,10 +228,10 @@ public:
 
         // Produce digest (little-endian of a_, b_, c_, d_)
         std::array<uint8_t, 16> out{};
-        write_le32(out.data() + 0,  a_);
-        write_le32(out.data() + 4,  b_);
-        write_le32(out.data() + 8,  c_);
-        write_le32(out.data() + 12, d_);
+        md5_detail::write_le32(out.data() + 0,  a_);
+        md5_detail::write_le32(out.data() + 4,  b_);
+        md5_detail::write_le32(out.data() + 8,  c_);
+        md5_detail::write_le32(out.data() + 12, d_);
 
         // Prepare for reuse
         reset();
@@ -96,6 +245,37 @@ public:
     static std::array<uint8_t,16> digest(const std::string& s) {
         return digest(s.data(), s.size());
     }
+
+    // Fast path for messages of at most 55 bytes: the message, padding and
+    // length fit one block, which is built on the stack and compressed
+    // once with no buffering. Longer inputs fall back to digest().
+    static std::array<uint8_t,16> digest_short(const void* data, std::size_t len) {
+        static const State init{0x67452301u, 0xefcdab89u, 0x98badcfeu, 0x10325476u, 0};
+        return digest_suffix(init, data, len);
+    }
+
+    // Hash prefix || suffix given the snapshot of the prefix; single-block
+    // fast path when the suffix is at most 55 bytes.
+    static std::array<uint8_t,16> digest_suffix(const State& prefix, const void* suffix,
+                                                std::size_t len) {
+        if (len > 55) {
+            MD5 m(prefix); m.update(suffix, len); return m.finalize();
+        }
+        uint8_t block[64];
+        std::memcpy(block, suffix, len);
+        block[len] = 0x80;
+        std::memset(block + len + 1, 0, 55 - len);
+        uint64_t bit_len = (prefix.prefix_len + len) * 8ULL;
+        md5_detail::write_le32(block + 56, static_cast<uint32_t>(bit_len));
+        md5_detail::write_le32(block + 60, static_cast<uint32_t>(bit_len >> 32));
+
+        uint32_t st[4] = {prefix.a, prefix.b, prefix.c, prefix.d};
+        md5_detail::compress_unrolled(st, block);
+        std::array<uint8_t, 16> out;
+        for (int i = 0; i < 4; ++i) md5_detail::write_le32(out.data() + 4*i, st[i]);
+        return out;
+    }
+
     static std::string hex(const std::array<uint8_t,16>& d) {
         static const char* hexd = "0123456789abcdef";
         std::string s; s.resize(32);
@@ -109,69 +289,13 @@ public:
 private:
     // Core transformation on one 512-bit block (64 bytes)
     void transform(const uint8_t block[64]) {
-        uint32_t M[16];
-        for (int i = 0; i < 16; ++i) {
-            M[i] = read_le32(block + 4*i);
-        }
-
-        uint32_t A = a_, B = b_, C = c_, D = d_;
-
-        auto F = [](uint32_t x, uint32_t y, uint32_t z) { return (x & y) | (~x & z); };
-        auto G = [](uint32_t x, uint32_t y, uint32_t z) { return (x & z) | (y & ~z); };
-        auto H = [](uint32_t x, uint32_t y, uint32_t z) { return x ^ y ^ z; };
-        auto I = [](uint32_t x, uint32_t y, uint32_t z) { return y ^ (x | ~z); };
-
-        auto rotl = [](uint32_t v, uint32_t s) { return (v << s) | (v >> (32 - s)); };
-
-        // Per-round shift amounts
-        static const uint32_t S[64] = {
-            7,12,17,22, 7,12,17,22, 7,12,17,22, 7,12,17,22,
-            5, 9,14,20, 5, 9,14,20, 5, 9,14,20, 5, 9,14,20,
-            4,11,16,23, 4,11,16,23, 4,11,16,23, 4,11,16,23,
-            6,10,15,21, 6,10,15,21, 6,10,15,21, 6,10,15,21
-        };
-
-        // Constants K[i] = floor(2^32 * abs(sin(i+1)))
-        static const uint32_t K[64] = {
-            0xd76aa478u,0xe8c7b756u,0x242070dbu,0xc1bdceeeu,0xf57c0fafu,0x4787c62au,0xa8304613u,0xfd469501u,
-            0x698098d8u,0x8b44f7afu,0xffff5bb1u,0x895cd7beu,0x6b901122u,0xfd987193u,0xa679438eu,0x49b40821u,
-            0xf61e2562u,0xc040b340u,0x265e5a51u,0xe9b6c7aau,0xd62f105du,0x02441453u,0xd8a1e681u,0xe7d3fbc8u,
-            0x21e1cde6u,0xc33707d6u,0xf4d50d87u,0x455a14edu,0xa9e3e905u,0xfcefa3f8u,0x676f02d9u,0x8d2a4c8au,
-            0xfffa3942u,0x8771f681u,0x6d9d6122u,0xfde5380cu,0xa4beea44u,0x4bdecfa9u,0xf6bb4b60u,0xbebfbc70u,
-            0x289b7ec6u,0xeaa127fau,0xd4ef3085u,0x04881d05u,0xd9d4d039u,0xe6db99e5u,0x1fa27cf8u,0xc4ac5665u,
-            0xf4292244u,0x432aff97u,0xab9423a7u,0xfc93a039u,0x655b59c3u,0x8f0ccc92u,0xffeff47du,0x85845dd1u,
-            0x6fa87e4fu,0xfe2ce6e0u,0xa3014314u,0x4e0811a1u,0xf7537e82u,0xbd3af235u,0x2ad7d2bbu,0xeb86d391u
-        };
-
-        for (uint32_t i = 0; i < 64; ++i) {
-            uint32_t f, g;
-            if (i < 16)       { f = F(B, C, D); g = i; }
-            else if (i < 32)  { f = G(B, C, D); g = (5*i + 1) & 15u; }
-            else if (i < 48)  { f = H(B, C, D); g = (3*i + 5) & 15u; }
-            else              { f = I(B, C, D); g = (7*i)      & 15u; }
-
-            uint32_t tmp = D;
-            D = C;
-            C = B;
-            uint32_t sum = A + f + K[i] + M[g];
-            B = B + rotl(sum, S[i]);
-            A = tmp;
-        }
-
-        a_ += A; b_ += B; c_ += C; d_ += D;
-    }
-
-    static uint32_t read_le32(const uint8_t* p) {
-        return (uint32_t)p[0]
-             | ((uint32_t)p[1] << 8)
-             | ((uint32_t)p[2] << 16)
-             | ((uint32_t)p[3] << 24);
-    }
-    static void write_le32(uint8_t* p, uint32_t v) {
-        p[0] = (uint8_t)(v & 0xFFu);
-        p[1] = (uint8_t)((v >> 8) & 0xFFu);
-        p[2] = (uint8_t)((v >> 16) & 0xFFu);
-        p[3] = (uint8_t)((v >> 24) & 0xFFu);
+        uint32_t st[4] = {a_, b_, c_, d_};
+#ifdef MD5_REFERENCE_TRANSFORM
+        md5_detail::compress_reference(st, block);
+#else
+        md5_detail::compress_unrolled(st, block);
+#endif
+        a_ = st[0]; b_ = st[1]; c_ = st[2]; d_ = st[3];
     }
 
     // State
@@ -181,6 +305,8 @@ private:
     std::size_t buffer_len_;
 };
 
+#endif // MD5_HPP
+
 // ------------------------
 // Optional quick test main
 // Define MD5_TEST before compiling this file to run self-tests.
@@ -204,7 +330,18 @@ int main() {
         auto hx = MD5::hex(d);
         std::cout << "\"" << t.s << "\" -> " << hx << (hx == t.h ? "  OK" : "  **MISMATCH**") << "\n";
         if (hx != t.h) ok = false;
+        if (std::strlen(t.s) <= 55 && MD5::digest_short(t.s, std::strlen(t.s)) != d) {
+            std::cout << "  digest_short **MISMATCH**\n";
+            ok = false;
+        }
     }
-    return ok ? 0 : 1;
+
+    // Resume from a 64-byte prefix snapshot
+    const char* msg = tv[6].s;
+    MD5 pre; pre.update(msg, 64);
+    MD5::State st;
+    bool resumed = pre.snapshot(st) && MD5::hex(MD5::digest_suffix(st, msg + 64, 16)) == tv[6].h;
+    std::cout << "prefix snapshot + suffix -> " << (resumed ? "OK" : "**MISMATCH**") << "\n";
+    return (ok && resumed) ? 0 : 1;
 }
 #endif
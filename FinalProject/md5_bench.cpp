@@ -0,0 +1,154 @@
+// MD5 throughput benchmark suite with machine-readable JSON output.
+//
+//   md5_bench [--max-size BYTES] [--min-time SECONDS] [--seed N] > result.json
+//
+// Cases, for message sizes from 0 B up to --max-size (default 1 GiB):
+//   digest         MD5::digest one message at a time
+//   digest_short   MD5::digest_short (sizes <= 55 only)
+//   update/<c>     incremental MD5::update in c-byte pieces (sub-block
+//                  pieces only up to 1 MiB messages)
+//   batch/<isa>    MD5xN::digest_batch, for each ISA this CPU supports
+//                  (sizes <= 64 KiB, where batching short messages matters)
+// Inputs come from a seeded splitmix64 stream, so a corpus is identical
+// across runs and machines; its MD5 is recorded in the output so runs can be
+// matched up. Cycles are TSC cycles (reference clock, not core clock).
+
+#include "md5xn.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+static uint64_t cycles() { return __rdtsc(); }
+#else
+static uint64_t cycles() { return 0; }
+#endif
+
+struct Corpus {
+    std::vector<uint8_t> bytes;
+
+    Corpus(std::size_t n, uint64_t seed) : bytes(n) {
+        uint64_t s = seed;
+        for (std::size_t i = 0; i < n; i += 8) {
+            uint64_t z = (s += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z ^= z >> 31;
+            std::memcpy(bytes.data() + i, &z, std::min<std::size_t>(8, n - i));
+        }
+    }
+};
+
+struct Result {
+    std::string name;
+    std::size_t msg_size;
+    uint64_t messages;
+    double seconds;
+    uint64_t tsc;
+};
+
+// Run fn (which hashes `per_call` messages) until min_time has elapsed.
+// The clock is read once per doubling round, not per call, so it does not
+// dominate the tiny-message cases.
+template <typename F>
+static Result measure(const std::string& name, std::size_t msg_size, std::size_t per_call,
+                      double min_time, F fn) {
+    fn();   // warm-up: page in the corpus, resolve dispatch
+    uint64_t calls = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t c0 = cycles();
+    double sec = 0;
+    for (uint64_t reps = 1; sec < min_time; reps *= 2) {
+        for (uint64_t r = 0; r < reps; ++r) fn();
+        calls += reps;
+        sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+    return Result{name, msg_size, calls * per_call, sec, cycles() - c0};
+}
+
+static volatile uint8_t sink;
+
+int main(int argc, char* argv[]) {
+    std::size_t max_size = std::size_t(1) << 30;
+    double min_time = 0.25;
+    uint64_t seed = 455;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--max-size") == 0)      max_size = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--min-time") == 0) min_time = std::strtod(argv[i + 1], nullptr);
+        else if (std::strcmp(argv[i], "--seed") == 0)     seed = std::strtoull(argv[i + 1], nullptr, 10);
+    }
+
+    // Batched cases hash many messages per call: lay them out back to back
+    const std::size_t batch_bytes = std::size_t(4) << 20;
+    Corpus corpus(std::max(max_size, batch_bytes), seed);
+    const uint8_t* base = corpus.bytes.data();
+
+    std::vector<std::size_t> sizes = {0, 1, 16, 55, 56, 64, 256, 1024, 4096, 65536};
+    for (std::size_t s = std::size_t(1) << 20; s <= max_size; s <<= 4) sizes.push_back(s);
+    if (sizes.back() != max_size && max_size > 65536) sizes.push_back(max_size);
+
+    std::vector<Result> results;
+    for (std::size_t size : sizes) {
+        if (size > max_size) continue;
+
+        results.push_back(measure("digest", size, 1, min_time, [&] {
+            sink = sink + MD5::digest(base, size)[0];
+        }));
+
+        if (size <= 55) {
+            results.push_back(measure("digest_short", size, 1, min_time, [&] {
+                sink = sink + MD5::digest_short(base, size)[0];
+            }));
+        }
+
+        for (std::size_t chunk : {std::size_t(1), std::size_t(13), std::size_t(64), std::size_t(4096)}) {
+            if (size < 4 * chunk || (chunk < 64 && size > (std::size_t(1) << 20))) continue;
+            results.push_back(measure("update/" + std::to_string(chunk), size, 1, min_time, [&] {
+                MD5 m;
+                for (std::size_t off = 0; off < size; off += chunk) m.update(base + off, std::min(chunk, size - off));
+                sink = sink + m.finalize()[0];
+            }));
+        }
+
+        if (size <= 65536) {
+            std::size_t n = std::max<std::size_t>(64, batch_bytes / std::max<std::size_t>(size, 64));
+            std::vector<const uint8_t*> ptrs(n);
+            std::vector<std::size_t> lens(n, size);
+            std::vector<std::array<uint8_t, 16>> out(n);
+            for (std::size_t i = 0; i < n; ++i) ptrs[i] = base + (i * size) % (corpus.bytes.size() - size + 1);
+
+            const MD5xN::Isa isas[] = {MD5xN::Isa::SSE2, MD5xN::Isa::AVX2, MD5xN::Isa::AVX512};
+            for (auto isa : isas) {
+                if (MD5xN::lanes(isa) > MD5xN::lanes(MD5xN::detect())) continue;
+                results.push_back(measure(std::string("batch/") + MD5xN::name(isa), size, n, min_time, [&] {
+                    MD5xN::digest_batch(ptrs.data(), lens.data(), n, out.data(), isa);
+                    sink = sink + out[0][0];
+                }));
+            }
+        }
+    }
+
+    std::printf("{\n");
+    std::printf("  \"seed\": %llu,\n", (unsigned long long)seed);
+    std::printf("  \"corpus_bytes\": %zu,\n", corpus.bytes.size());
+    std::printf("  \"corpus_md5\": \"%s\",\n", MD5::hex(MD5::digest(base, corpus.bytes.size())).c_str());
+    std::printf("  \"isa\": \"%s\",\n", MD5xN::name(MD5xN::detect()));
+    std::printf("  \"min_time_s\": %g,\n", min_time);
+    std::printf("  \"results\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        double bytes = static_cast<double>(r.messages) * r.msg_size;
+        std::printf("    {\"case\": \"%s\", \"msg_size\": %zu, \"messages\": %llu, \"seconds\": %.6f, "
+                    "\"ns_per_msg\": %.3f, \"tsc_cycles_per_byte\": %.3f, \"gb_per_s\": %.4f}%s\n",
+                    r.name.c_str(), r.msg_size, (unsigned long long)r.messages, r.seconds,
+                    r.seconds * 1e9 / r.messages, bytes > 0 ? r.tsc / bytes : 0.0,
+                    r.seconds > 0 ? bytes / r.seconds / 1e9 : 0.0, i + 1 < results.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,249 @@
+// md5sum.hpp — public domain / CC0
+// Parallel file and directory hashing on top of the MD5 class. Files are
+// spread over a worker pool; large files are mmap'ed, small ones pread into
+// an aligned buffer, and the next chunk is always prefetched (madvise /
+// posix_fadvise WILLNEED) while the current one is hashed so disk I/O and
+// hashing overlap.
+#pragma once
+
+#include "md5.cpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct FileDigest {
+    std::string path;
+    std::array<uint8_t, 16> digest{};
+    uint64_t bytes = 0;
+    double io_seconds = 0;     // time blocked in pread / faulting in mmap'ed pages
+    double hash_seconds = 0;   // time inside MD5::update
+    bool ok = false;
+    std::string error;
+};
+
+struct HashReport {
+    std::vector<FileDigest> files;   // in the order the paths were expanded
+    uint64_t total_bytes = 0;
+    double wall_seconds = 0;
+    double io_seconds = 0;
+    double hash_seconds = 0;
+
+    double mb_per_s() const {
+        return wall_seconds > 0 ? total_bytes / wall_seconds / 1e6 : 0.0;
+    }
+    // I/O time dominates hashing time across all workers
+    bool disk_bound() const { return io_seconds > hash_seconds; }
+};
+
+struct HashOptions {
+    std::size_t chunk_size = 8u << 20;     // bytes hashed per step; multiple of 64
+    uint64_t mmap_threshold = 1u << 20;    // files at least this big are mmap'ed
+};
+
+namespace md5sum_detail {
+
+using clock = std::chrono::steady_clock;
+
+inline double seconds_since(clock::time_point t0) {
+    return std::chrono::duration<double>(clock::now() - t0).count();
+}
+
+// Append the regular files under dir (not following directory symlinks).
+// A directory that cannot be read becomes a failed entry of its own, so the
+// walk goes on and the miss still shows up in the exit status.
+inline void walk(const std::filesystem::path& dir, std::vector<FileDigest>& out) {
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    for (auto it = fs::directory_iterator(dir, ec);
+         !ec && it != fs::directory_iterator(); it.increment(ec)) {
+        std::error_code sec;
+        if (fs::is_directory(it->symlink_status(sec))) {
+            walk(it->path(), out);
+        } else if (it->is_regular_file(sec)) {
+            out.emplace_back();
+            out.back().path = it->path().string();
+        }
+    }
+    if (ec) {
+        out.emplace_back();
+        out.back().path = dir.string();
+        out.back().error = ec.message();
+    }
+}
+
+// Expand directories recursively (sorted, regular files only); plain paths
+// are kept as given so missing files still show up as errors.
+inline std::vector<FileDigest> expand(const std::vector<std::string>& paths) {
+    namespace fs = std::filesystem;
+    std::vector<FileDigest> out;
+    for (const auto& p : paths) {
+        std::error_code ec;
+        if (fs::is_directory(p, ec)) {
+            std::size_t first = out.size();
+            walk(p, out);
+            std::sort(out.begin() + first, out.end(),
+                      [](const FileDigest& a, const FileDigest& b) { return a.path < b.path; });
+        } else {
+            out.emplace_back();
+            out.back().path = p;
+        }
+    }
+    return out;
+}
+
+// Page-aligned buffer of at least size bytes so the kernel can copy whole
+// pages (aligned_alloc wants a multiple of the alignment). Null on failure;
+// release with std::free.
+inline uint8_t* alloc_buffer(std::size_t size) {
+    size = (std::max<std::size_t>(size, 1) + 4095) / 4096 * 4096;
+    return static_cast<uint8_t*>(std::aligned_alloc(4096, size));
+}
+
+// pread until len bytes are read or the file ends; -1 on error
+inline ssize_t pread_full(int fd, uint8_t* buf, std::size_t len, uint64_t off) {
+    std::size_t got = 0;
+    while (got < len) {
+        ssize_t n = ::pread(fd, buf + got, len - got, static_cast<off_t>(off + got));
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        if (n == 0) break;
+        got += static_cast<std::size_t>(n);
+    }
+    return static_cast<ssize_t>(got);
+}
+
+// Fault in every page of [p, p+len) so the page faults are timed as I/O
+// rather than landing inside MD5::update.
+inline void touch_pages(const uint8_t* p, std::size_t len) {
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    volatile uint8_t sink = 0;
+    for (std::size_t i = 0; i < len; i += page) sink = sink + p[i];
+    if (len) sink = sink + p[len - 1];
+}
+
+// false if the file could not be mapped; r is left untouched
+inline bool hash_mmap(int fd, FileDigest& r, const HashOptions& opt) {
+    void* base = ::mmap(nullptr, r.bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) return false;
+    ::madvise(base, r.bytes, MADV_SEQUENTIAL);
+
+    const uint8_t* p = static_cast<const uint8_t*>(base);
+    MD5 md5;
+    for (uint64_t off = 0; off < r.bytes; off += opt.chunk_size) {
+        std::size_t len = static_cast<std::size_t>(std::min<uint64_t>(opt.chunk_size, r.bytes - off));
+        uint64_t next = off + len;
+        if (next < r.bytes) {
+            ::madvise(const_cast<uint8_t*>(p) + next,
+                      static_cast<std::size_t>(std::min<uint64_t>(opt.chunk_size, r.bytes - next)),
+                      MADV_WILLNEED);
+        }
+        auto t0 = clock::now();
+        touch_pages(p + off, len);
+        r.io_seconds += seconds_since(t0);
+        t0 = clock::now();
+        md5.update(p + off, len);
+        r.hash_seconds += seconds_since(t0);
+    }
+    r.digest = md5.finalize();
+    ::munmap(base, r.bytes);
+    r.ok = true;
+    return true;
+}
+
+inline void hash_pread(int fd, FileDigest& r, const HashOptions& opt, uint8_t* buf,
+                       bool seekable = true) {
+    MD5 md5;
+    uint64_t off = 0;
+    for (;;) {
+        ::posix_fadvise(fd, static_cast<off_t>(off + opt.chunk_size),
+                        static_cast<off_t>(opt.chunk_size), POSIX_FADV_WILLNEED);
+        auto t0 = clock::now();
+        ssize_t got = seekable ? ::pread(fd, buf, opt.chunk_size, static_cast<off_t>(off))
+                               : ::read(fd, buf, opt.chunk_size);
+        r.io_seconds += seconds_since(t0);
+        if (got < 0) { r.error = "read failed"; return; }
+        if (got == 0) break;
+        t0 = clock::now();
+        md5.update(buf, static_cast<std::size_t>(got));
+        r.hash_seconds += seconds_since(t0);
+        off += static_cast<uint64_t>(got);
+    }
+    r.bytes = off;
+    r.digest = md5.finalize();
+    r.ok = true;
+}
+
+inline void hash_file(FileDigest& r, const HashOptions& opt, uint8_t* buf) {
+    // "-" is standard input, as in coreutils
+    int fd = (r.path == "-") ? STDIN_FILENO : ::open(r.path.c_str(), O_RDONLY);
+    if (fd < 0) { r.error = std::strerror(errno); return; }
+    struct stat sb;
+    if (::fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode)) {
+        // pipes, devices, ...: stream them
+        if (buf) hash_pread(fd, r, opt, buf, false);
+        else r.error = "out of memory";
+    } else {
+        r.bytes = static_cast<uint64_t>(sb.st_size);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        // a file that cannot be mapped is still readable: pread it instead
+        bool mapped = r.bytes >= opt.mmap_threshold && hash_mmap(fd, r, opt);
+        if (!mapped) {
+            if (buf) hash_pread(fd, r, opt, buf);
+            else r.error = "out of memory";
+        }
+    }
+    if (fd != STDIN_FILENO) ::close(fd);
+}
+
+} // namespace md5sum_detail
+
+// Hash every file named in paths (directories are walked recursively) using
+// the given number of worker threads (0 = hardware concurrency).
+inline HashReport hash_paths(const std::vector<std::string>& paths, unsigned threads,
+                             const HashOptions& opt = {}) {
+    using namespace md5sum_detail;
+    HashReport rep;
+    auto t0 = clock::now();
+
+    rep.files = expand(paths);
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, rep.files.size())));
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        // on failure buf is null and only the mmap path is available
+        uint8_t* buf = alloc_buffer(opt.chunk_size);
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < rep.files.size(); ) {
+            // unreadable directories come out of expand already failed
+            if (rep.files[i].error.empty()) hash_file(rep.files[i], opt, buf);
+        }
+        std::free(buf);
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+
+    for (const auto& f : rep.files) {
+        rep.total_bytes += f.bytes;
+        rep.io_seconds += f.io_seconds;
+        rep.hash_seconds += f.hash_seconds;
+    }
+    rep.wall_seconds = seconds_since(t0);
+    return rep;
+}
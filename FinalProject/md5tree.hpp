@@ -0,0 +1,328 @@
+// md5tree.hpp — public domain / CC0
+// Tree-mode (Merkle) MD5 for large buffers and files. The input is split into
+// fixed-size chunks hashed in parallel; chunk digests are the leaves of a
+// binary tree whose top commits, together with the chunk size and the total
+// length, to the root that identifies the whole input. Leaves, inner nodes
+// and the root are domain-separated (RFC 6962 style) so a root can never
+// collide with a plain leaf or node:
+//
+//   leaf   = MD5(0x00 || chunk)
+//   parent = MD5(0x01 || left || right)      (an odd last node is promoted)
+//   root   = MD5(0x02 || le64(chunk_size) || le64(total_len) || top)
+//
+// Note the root is NOT equal to MD5 of the whole input.
+//
+// A tree can be saved and loaded (md5_tree_serialize / md5_tree_deserialize)
+// so a file can later be verified or updated chunk by chunk through the
+// pread / mmap reader of md5sum.hpp without holding it in memory.
+#pragma once
+
+#include "md5.cpp"
+#include "md5sum.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct MD5Tree {
+    std::size_t chunk_size = 1u << 20;         // multiple of 64
+    uint64_t total_len = 0;
+    std::vector<std::array<uint8_t, 16>> chunks; // leaf digest per chunk
+    std::array<uint8_t, 16> root{};
+
+    std::size_t num_chunks() const { return chunks.size(); }
+};
+
+namespace md5tree_detail {
+
+inline std::array<uint8_t, 16> leaf(const uint8_t* p, std::size_t len) {
+    static const uint8_t tag = 0x00;
+    MD5 m; m.update(&tag, 1); m.update(p, len); return m.finalize();
+}
+
+inline std::array<uint8_t, 16> parent(const std::array<uint8_t, 16>& l,
+                                      const std::array<uint8_t, 16>& r) {
+    uint8_t buf[33];
+    buf[0] = 0x01;
+    std::memcpy(buf + 1, l.data(), 16);
+    std::memcpy(buf + 17, r.data(), 16);
+    return MD5::digest_short(buf, sizeof(buf));
+}
+
+inline std::array<uint8_t, 16> fold(std::vector<std::array<uint8_t, 16>> level) {
+    if (level.empty()) return leaf(nullptr, 0);
+    while (level.size() > 1) {
+        std::size_t n = level.size() / 2;
+        for (std::size_t i = 0; i < n; ++i) level[i] = parent(level[2*i], level[2*i + 1]);
+        if (level.size() & 1) level[n++] = level.back();
+        level.resize(n);
+    }
+    return level[0];
+}
+
+inline void put_le64(uint8_t* p, uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<uint8_t>(v >> (8 * i));
+}
+
+inline uint64_t get_le64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 8; i-- > 0; ) v = (v << 8) | p[i];
+    return v;
+}
+
+// Root over the chunk digests, the chunk size and the total length
+inline std::array<uint8_t, 16> root(const MD5Tree& t) {
+    uint8_t buf[33];
+    buf[0] = 0x02;
+    put_le64(buf + 1, t.chunk_size);
+    put_le64(buf + 9, t.total_len);
+    std::memcpy(buf + 17, fold(t.chunks).data(), 16);
+    return MD5::digest_short(buf, sizeof(buf));
+}
+
+inline std::size_t num_chunks(uint64_t total_len, std::size_t chunk_size) {
+    return static_cast<std::size_t>((total_len + chunk_size - 1) / chunk_size);
+}
+
+// Hash the listed chunk indices of tree in parallel
+inline void hash_chunks(MD5Tree& t, const uint8_t* data, const std::vector<std::size_t>& which,
+                        unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, std::max<std::size_t>(1, which.size())));
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < which.size(); ) {
+            std::size_t c = which[i];
+            uint64_t off = static_cast<uint64_t>(c) * t.chunk_size;
+            std::size_t len = static_cast<std::size_t>(std::min<uint64_t>(t.chunk_size, t.total_len - off));
+            t.chunks[c] = leaf(data + off, len);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; ++k) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+}
+
+// Hash the listed chunk indices of tree from an open file of t.total_len
+// bytes: mmap'ed when at least opt.mmap_threshold bytes, otherwise pread a
+// chunk at a time into one aligned buffer per thread. Returns false on an
+// I/O error or a file that is shorter than expected.
+inline bool hash_file_chunks(MD5Tree& t, int fd, const std::vector<std::size_t>& which,
+                             unsigned threads, const HashOptions& opt = {}) {
+    if (which.empty()) return true;
+    if (t.total_len >= opt.mmap_threshold) {
+        void* base = ::mmap(nullptr, t.total_len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (base == MAP_FAILED) return false;
+        ::madvise(base, t.total_len, MADV_WILLNEED);
+        hash_chunks(t, static_cast<const uint8_t*>(base), which, threads);
+        ::munmap(base, t.total_len);
+        return true;
+    }
+
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, which.size()));
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> ok{true};
+    auto worker = [&]() {
+        uint8_t* buf = md5sum_detail::alloc_buffer(t.chunk_size);
+        if (!buf) { ok = false; return; }
+        for (std::size_t i; ok && (i = next.fetch_add(1, std::memory_order_relaxed)) < which.size(); ) {
+            std::size_t c = which[i];
+            uint64_t off = static_cast<uint64_t>(c) * t.chunk_size;
+            std::size_t len = static_cast<std::size_t>(std::min<uint64_t>(t.chunk_size, t.total_len - off));
+            if (md5sum_detail::pread_full(fd, buf, len, off) != static_cast<ssize_t>(len)) { ok = false; break; }
+            t.chunks[c] = leaf(buf, len);
+        }
+        std::free(buf);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned k = 1; k < threads; ++k) pool.emplace_back(worker);
+    worker();
+    for (auto& th : pool) th.join();
+    return ok;
+}
+
+// Open path and return its size in len; -1 if it cannot be opened
+inline int open_file(const std::string& path, uint64_t& len) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat sb;
+    if (::fstat(fd, &sb) != 0 || !S_ISREG(sb.st_mode)) { ::close(fd); return -1; }
+    len = static_cast<uint64_t>(sb.st_size);
+    return fd;
+}
+
+} // namespace md5tree_detail
+
+// Build the tree over data[0, len) with the given chunk size and threads
+// (0 = hardware concurrency).
+inline MD5Tree md5_tree(const void* data, std::size_t len, std::size_t chunk_size = 1u << 20,
+                        unsigned threads = 0) {
+    MD5Tree t;
+    t.chunk_size = std::max<std::size_t>(64, chunk_size / 64 * 64);
+    t.total_len = len;
+    t.chunks.resize((len + t.chunk_size - 1) / t.chunk_size);
+
+    std::vector<std::size_t> all(t.chunks.size());
+    for (std::size_t i = 0; i < all.size(); ++i) all[i] = i;
+    md5tree_detail::hash_chunks(t, static_cast<const uint8_t*>(data), all, threads);
+    t.root = md5tree_detail::root(t);
+    return t;
+}
+
+// Re-hash only the chunks overlapping [offset, offset + length) after the
+// buffer was modified in place (same total length) and refresh the root.
+inline void md5_tree_update(MD5Tree& t, const void* data, uint64_t offset, uint64_t length,
+                            unsigned threads = 0) {
+    if (length == 0 || offset >= t.total_len) return;
+    uint64_t last = std::min(offset + length, t.total_len) - 1;
+    std::vector<std::size_t> which;
+    for (uint64_t c = offset / t.chunk_size; c <= last / t.chunk_size; ++c) {
+        which.push_back(static_cast<std::size_t>(c));
+    }
+    md5tree_detail::hash_chunks(t, static_cast<const uint8_t*>(data), which, threads);
+    t.root = md5tree_detail::root(t);
+}
+
+// Indices of chunks whose digests differ between two trees built with the
+// same chunk size; chunks present in only one tree count as changed.
+inline std::vector<std::size_t> md5_tree_diff(const MD5Tree& a, const MD5Tree& b) {
+    std::vector<std::size_t> out;
+    std::size_t n = std::max(a.chunks.size(), b.chunks.size());
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i >= a.chunks.size() || i >= b.chunks.size() || a.chunks[i] != b.chunks[i]) out.push_back(i);
+    }
+    return out;
+}
+
+// Re-verify a buffer against a stored tree; returns the mismatching chunks
+inline std::vector<std::size_t> md5_tree_verify(const MD5Tree& t, const void* data, std::size_t len,
+                                                unsigned threads = 0) {
+    return md5_tree_diff(t, md5_tree(data, len, t.chunk_size, threads));
+}
+
+// Tree over a whole file, read chunk by chunk with the md5sum.hpp reader
+// (mmap for large files, pread otherwise). Returns false if it cannot be read.
+inline bool md5_tree_file(const std::string& path, MD5Tree& t, std::size_t chunk_size = 1u << 20,
+                          unsigned threads = 0) {
+    uint64_t len = 0;
+    int fd = md5tree_detail::open_file(path, len);
+    if (fd < 0) return false;
+
+    MD5Tree out;
+    out.chunk_size = std::max<std::size_t>(64, chunk_size / 64 * 64);
+    out.total_len = len;
+    out.chunks.resize(md5tree_detail::num_chunks(len, out.chunk_size));
+
+    std::vector<std::size_t> all(out.chunks.size());
+    for (std::size_t i = 0; i < all.size(); ++i) all[i] = i;
+    bool ok = md5tree_detail::hash_file_chunks(out, fd, all, threads);
+    ::close(fd);
+    if (!ok) return false;
+
+    out.root = md5tree_detail::root(out);
+    t = std::move(out);
+    return true;
+}
+
+// Re-verify a file against a stored tree without loading it whole; the
+// mismatching chunks go to bad (chunks present in only one of the file and
+// the tree count too). Returns false if the file cannot be read.
+inline bool md5_tree_verify_file(const MD5Tree& t, const std::string& path,
+                                 std::vector<std::size_t>& bad, unsigned threads = 0) {
+    MD5Tree now;
+    if (!md5_tree_file(path, now, t.chunk_size, threads)) return false;
+    bad = md5_tree_diff(t, now);
+    return true;
+}
+
+// Re-hash only the chunks of a file overlapping [offset, offset + length)
+// after it was modified, and refresh the root. A file that grew or shrank
+// also re-hashes its chunks from the old or new end, whichever comes first.
+// Returns false if the file cannot be read; t is unchanged then.
+inline bool md5_tree_update_file(MD5Tree& t, const std::string& path, uint64_t offset,
+                                 uint64_t length, unsigned threads = 0) {
+    uint64_t len = 0;
+    int fd = md5tree_detail::open_file(path, len);
+    if (fd < 0) return false;
+
+    MD5Tree out = t;
+    out.total_len = len;
+    out.chunks.resize(md5tree_detail::num_chunks(len, out.chunk_size));
+
+    std::vector<std::size_t> which;
+    if (length > 0 && offset < len) {
+        uint64_t last = std::min(offset + length, len) - 1;
+        for (uint64_t c = offset / out.chunk_size; c <= last / out.chunk_size; ++c) {
+            which.push_back(static_cast<std::size_t>(c));
+        }
+    }
+    if (len != t.total_len) {
+        for (std::size_t c = static_cast<std::size_t>(std::min(len, t.total_len) / out.chunk_size);
+             c < out.chunks.size(); ++c) {
+            which.push_back(c);
+        }
+        std::sort(which.begin(), which.end());
+        which.erase(std::unique(which.begin(), which.end()), which.end());
+    }
+
+    bool ok = md5tree_detail::hash_file_chunks(out, fd, which, threads);
+    ::close(fd);
+    if (!ok) return false;
+
+    out.root = md5tree_detail::root(out);
+    t = std::move(out);
+    return true;
+}
+
+// Save a tree as "MD5TREE1", le64 chunk size, le64 total length, the chunk
+// digests and the root.
+inline bool md5_tree_serialize(std::ostream& os, const MD5Tree& t) {
+    uint8_t head[24];
+    std::memcpy(head, "MD5TREE1", 8);
+    md5tree_detail::put_le64(head + 8, t.chunk_size);
+    md5tree_detail::put_le64(head + 16, t.total_len);
+    os.write(reinterpret_cast<const char*>(head), sizeof(head));
+    for (const auto& c : t.chunks) os.write(reinterpret_cast<const char*>(c.data()), 16);
+    os.write(reinterpret_cast<const char*>(t.root.data()), 16);
+    return static_cast<bool>(os);
+}
+
+// Load a tree saved by md5_tree_serialize. Returns false, leaving t
+// unchanged, on a truncated or malformed stream or a root that does not
+// match the chunk digests, chunk size and length.
+inline bool md5_tree_deserialize(std::istream& is, MD5Tree& t) {
+    uint8_t head[24];
+    if (!is.read(reinterpret_cast<char*>(head), sizeof(head)) || std::memcmp(head, "MD5TREE1", 8) != 0) {
+        return false;
+    }
+    MD5Tree out;
+    uint64_t chunk_size = md5tree_detail::get_le64(head + 8);
+    out.total_len = md5tree_detail::get_le64(head + 16);
+    if (chunk_size < 64 || chunk_size % 64 != 0 || chunk_size > SIZE_MAX) return false;
+    out.chunk_size = static_cast<std::size_t>(chunk_size);
+
+    // read the digests as they come rather than trusting the length up front
+    uint64_t n = (out.total_len + out.chunk_size - 1) / out.chunk_size;
+    for (uint64_t i = 0; i < n; ++i) {
+        std::array<uint8_t, 16> d;
+        if (!is.read(reinterpret_cast<char*>(d.data()), 16)) return false;
+        out.chunks.push_back(d);
+    }
+    if (!is.read(reinterpret_cast<char*>(out.root.data()), 16)) return false;
+    if (out.root != md5tree_detail::root(out)) return false;
+    t = std::move(out);
+    return true;
+}
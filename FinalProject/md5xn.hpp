@@ -0,0 +1,200 @@
+// md5xn.hpp — public domain / CC0
+// Multi-buffer MD5: hashes 4/8/16 independent messages per transform by
+// running one message per SIMD lane (SSE2 / AVX2 / AVX-512), dispatched at
+// runtime by CPU feature. Results are byte-identical to MD5::digest.
+#pragma once
+
+#include "md5.cpp"
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <cstring>
+
+namespace md5_detail {
+
+// MD5 rounds written once against GCC/Clang vector extensions, so the
+// same source lowers to SSE2, AVX2 or AVX-512 depending on the target of the
+// function it is inlined into.
+template <typename V, std::size_t L>
+__attribute__((always_inline)) inline void compress_lanes(uint32_t (&st)[4][L],
+                                                          const uint32_t (&W)[16][L]) {
+    V M[16];
+    for (int j = 0; j < 16; ++j) std::memcpy(&M[j], W[j], sizeof(V));
+
+    V a, b, c, d;
+    std::memcpy(&a, st[0], sizeof(V));
+    std::memcpy(&b, st[1], sizeof(V));
+    std::memcpy(&c, st[2], sizeof(V));
+    std::memcpy(&d, st[3], sizeof(V));
+    V A = a, B = b, C = c, D = d;
+
+#pragma GCC unroll 64
+    for (uint32_t i = 0; i < 64; ++i) {
+        V f;
+        uint32_t g;
+        if (i < 16)       { f = (B & C) | (~B & D); g = i; }
+        else if (i < 32)  { f = (B & D) | (C & ~D); g = (5*i + 1) & 15u; }
+        else if (i < 48)  { f = B ^ C ^ D;          g = (3*i + 5) & 15u; }
+        else              { f = C ^ (B | ~D);       g = (7*i)      & 15u; }
+
+        V tmp = D;
+        D = C;
+        C = B;
+        V sum = A + f + K[i] + M[g];
+        B = B + ((sum << S[i]) | (sum >> (32 - S[i])));
+        A = tmp;
+    }
+
+    a += A; b += B; c += C; d += D;
+    std::memcpy(st[0], &a, sizeof(V));
+    std::memcpy(st[1], &b, sizeof(V));
+    std::memcpy(st[2], &c, sizeof(V));
+    std::memcpy(st[3], &d, sizeof(V));
+}
+
+typedef uint32_t u32x4  __attribute__((vector_size(16)));
+typedef uint32_t u32x8  __attribute__((vector_size(32)));
+typedef uint32_t u32x16 __attribute__((vector_size(64)));
+
+__attribute__((target("sse2"))) inline void compress_x4(uint32_t (&st)[4][4],
+                                                      const uint32_t (&W)[16][4]) {
+    compress_lanes<u32x4>(st, W);
+}
+__attribute__((target("avx2"))) inline void compress_x8(uint32_t (&st)[4][8],
+                                                      const uint32_t (&W)[16][8]) {
+    compress_lanes<u32x8>(st, W);
+}
+__attribute__((target("avx512f"))) inline void compress_x16(uint32_t (&st)[4][16],
+                                                          const uint32_t (&W)[16][16]) {
+    compress_lanes<u32x16>(st, W);
+}
+
+// Lane scheduler: every lane streams the blocks of one message; when a lane
+// finishes its digest is written out and the lane is refilled with the next
+// pending message, so short and long inputs can be mixed freely.
+template <std::size_t L, void (*Compress)(uint32_t (&)[4][L], const uint32_t (&)[16][L])>
+inline void digest_lanes(const uint8_t* const* msgs, const std::size_t* lens, std::size_t n,
+                         std::array<uint8_t, 16>* out) {
+    struct Lane {
+        const uint8_t* p;      // next full block of the message body
+        std::size_t full;      // full body blocks left
+        std::size_t tail;      // padded tail blocks left (1 or 2)
+        std::size_t idx;       // message index, or n when idle
+        uint8_t pad[128];      // remainder + 0x80 + zeros + bit length
+    };
+
+    static const uint8_t zero_block[64] = {};
+    Lane lanes[L];
+    uint32_t st[4][L];
+    uint32_t W[16][L];
+    std::size_t next = 0, active = 0;
+
+    auto refill = [&](std::size_t l) {
+        Lane& ln = lanes[l];
+        if (next == n) { ln.idx = n; return; }
+        ln.idx = next++;
+        std::size_t len = lens[ln.idx];
+        std::size_t rem = len % 64;
+        ln.p = msgs[ln.idx];
+        ln.full = len / 64;
+        ln.tail = (rem < 56) ? 1 : 2;
+        std::memcpy(ln.pad, ln.p + ln.full * 64, rem);
+        ln.pad[rem] = 0x80;
+        std::memset(ln.pad + rem + 1, 0, ln.tail * 64 - rem - 1);
+        uint64_t bit_len = static_cast<uint64_t>(len) * 8ULL;
+        for (int i = 0; i < 8; ++i) {
+            ln.pad[ln.tail * 64 - 8 + i] = static_cast<uint8_t>((bit_len >> (8 * i)) & 0xFFu);
+        }
+        st[0][l] = 0x67452301u;
+        st[1][l] = 0xefcdab89u;
+        st[2][l] = 0x98badcfeu;
+        st[3][l] = 0x10325476u;
+        ++active;
+    };
+
+    for (std::size_t l = 0; l < L; ++l) refill(l);
+
+    while (active > 0) {
+        for (std::size_t l = 0; l < L; ++l) {
+            const Lane& ln = lanes[l];
+            const uint8_t* blk;
+            if (ln.idx == n)      blk = zero_block;
+            else if (ln.full > 0) blk = ln.p;
+            else                  blk = ln.pad;   // current tail block is kept at the front
+            for (int j = 0; j < 16; ++j) W[j][l] = read_le32(blk + 4*j);
+        }
+
+        Compress(st, W);
+
+        for (std::size_t l = 0; l < L; ++l) {
+            Lane& ln = lanes[l];
+            if (ln.idx == n) continue;
+            if (ln.full > 0) { ln.p += 64; --ln.full; continue; }
+            if (--ln.tail > 0) { std::memmove(ln.pad, ln.pad + 64, 64); continue; }
+            uint8_t* o = out[ln.idx].data();
+            write_le32(o + 0,  st[0][l]);
+            write_le32(o + 4,  st[1][l]);
+            write_le32(o + 8,  st[2][l]);
+            write_le32(o + 12, st[3][l]);
+            --active;
+            refill(l);
+        }
+    }
+}
+
+} // namespace md5_detail
+
+class MD5xN {
+public:
+    enum class Isa { Scalar, SSE2, AVX2, AVX512 };
+
+    // Widest instruction set usable on this CPU
+    static Isa detect() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+        if (__builtin_cpu_supports("avx2"))    return Isa::AVX2;
+        if (__builtin_cpu_supports("sse2"))    return Isa::SSE2;
+#endif
+        return Isa::Scalar;
+    }
+
+    static std::size_t lanes(Isa isa) {
+        switch (isa) {
+            case Isa::SSE2:   return 4;
+            case Isa::AVX2:   return 8;
+            case Isa::AVX512: return 16;
+            default:          return 1;
+        }
+    }
+
+    static const char* name(Isa isa) {
+        switch (isa) {
+            case Isa::SSE2:   return "sse2";
+            case Isa::AVX2:   return "avx2";
+            case Isa::AVX512: return "avx512";
+            default:          return "scalar";
+        }
+    }
+
+    // Hash n independent messages; out[i] = MD5::digest(msgs[i], lens[i])
+    static void digest_batch(const uint8_t* const* msgs, const std::size_t* lens, std::size_t n,
+                             std::array<uint8_t, 16>* out) {
+        static const Isa best = detect();
+        digest_batch(msgs, lens, n, out, best);
+    }
+
+    // Same as above with an explicit instruction set (must be supported)
+    static void digest_batch(const uint8_t* const* msgs, const std::size_t* lens, std::size_t n,
+                             std::array<uint8_t, 16>* out, Isa isa) {
+        using namespace md5_detail;
+        switch (isa) {
+            case Isa::AVX512: digest_lanes<16, compress_x16>(msgs, lens, n, out); break;
+            case Isa::AVX2:   digest_lanes<8,  compress_x8 >(msgs, lens, n, out); break;
+            case Isa::SSE2:   digest_lanes<4,  compress_x4 >(msgs, lens, n, out); break;
+            default:
+                for (std::size_t i = 0; i < n; ++i) out[i] = MD5::digest(msgs[i], lens[i]);
+        }
+    }
+};
@@ -0,0 +1,103 @@
+// sha1.hpp — public domain / CC0
+// SHA-1 (FIPS 180-4) with the same incremental API as MD5
+// (update / finalize / digest / hex). Uses the x86 SHA extensions when the
+// CPU has them and a portable scalar transform otherwise.
+#pragma once
+
+#include "sha_common.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace sha_detail {
+
+inline void sha1_compress_scalar(uint32_t* st, const uint8_t* data, std::size_t nblocks) {
+    for (; nblocks > 0; --nblocks, data += 64) {
+        uint32_t W[80];
+        for (int i = 0; i < 16; ++i) W[i] = read_be32(data + 4*i);
+        for (int i = 16; i < 80; ++i) W[i] = rotl(W[i-3] ^ W[i-8] ^ W[i-14] ^ W[i-16], 1);
+
+        uint32_t a = st[0], b = st[1], c = st[2], d = st[3], e = st[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5a827999u; }
+            else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ed9eba1u; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8f1bbcdcu; }
+            else             { f = b ^ c ^ d;                   k = 0xca62c1d6u; }
+            uint32_t t = rotl(a, 5) + f + e + k + W[i];
+            e = d; d = c; c = rotl(b, 30); b = a; a = t;
+        }
+        st[0] += a; st[1] += b; st[2] += c; st[3] += d; st[4] += e;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// SHA-NI: sha1rnds4 does four rounds; E is carried in the top lane of a
+// vector and folded into the next message group by sha1nexte.
+__attribute__((target("sha,sse4.1")))
+inline void sha1_compress_shani(uint32_t* st, const uint8_t* data, std::size_t nblocks) {
+    const __m128i MASK = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(st)), 0x1B);
+    __m128i e0 = _mm_set_epi32(static_cast<int>(st[4]), 0, 0, 0);
+
+    for (; nblocks > 0; --nblocks, data += 64) {
+        const __m128i abcd_save = abcd, e_save = e0;
+        __m128i W[4];
+        __m128i prev = abcd;   // abcd at the start of the previous group
+#pragma GCC unroll 20
+        for (int i = 0; i < 20; ++i) {
+            __m128i w;
+            if (i < 4) {
+                w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i)), MASK);
+            } else {
+                w = _mm_sha1msg1_epu32(W[i & 3], W[(i + 1) & 3]);
+                w = _mm_xor_si128(w, W[(i + 2) & 3]);
+                w = _mm_sha1msg2_epu32(w, W[(i + 3) & 3]);
+            }
+            W[i & 3] = w;
+
+            __m128i e = (i == 0) ? _mm_add_epi32(e0, w) : _mm_sha1nexte_epu32(prev, w);
+            prev = abcd;
+            switch (i / 5) {
+                case 0:  abcd = _mm_sha1rnds4_epu32(abcd, e, 0); break;
+                case 1:  abcd = _mm_sha1rnds4_epu32(abcd, e, 1); break;
+                case 2:  abcd = _mm_sha1rnds4_epu32(abcd, e, 2); break;
+                default: abcd = _mm_sha1rnds4_epu32(abcd, e, 3); break;
+            }
+        }
+        e0 = _mm_sha1nexte_epu32(prev, e_save);
+        abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(st), _mm_shuffle_epi32(abcd, 0x1B));
+    st[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+}
+#endif
+
+} // namespace sha_detail
+
+class SHA1 : public sha_detail::Hasher<SHA1, 5> {
+public:
+    static void init(uint32_t* st) {
+        static const uint32_t iv[5] = {
+            0x67452301u, 0xefcdab89u, 0x98badcfeu, 0x10325476u, 0xc3d2e1f0u
+        };
+        std::memcpy(st, iv, sizeof(iv));
+    }
+
+    static constexpr sha_detail::CompressFn compress_scalar = sha_detail::sha1_compress_scalar;
+#if defined(__x86_64__) || defined(__i386__)
+    static constexpr sha_detail::CompressFn compress_shani = sha_detail::sha1_compress_shani;
+#else
+    static constexpr sha_detail::CompressFn compress_shani = nullptr;
+#endif
+
+    static sha_detail::CompressFn compress() {
+        // has_sha_ni() is always false where compress_shani is not built
+        static const sha_detail::CompressFn fn =
+            sha_detail::has_sha_ni() ? compress_shani : compress_scalar;
+        return fn;
+    }
+};
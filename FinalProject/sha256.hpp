@@ -0,0 +1,125 @@
+// sha256.hpp — public domain / CC0
+// SHA-256 (FIPS 180-4) with the same incremental API as MD5
+// (update / finalize / digest / hex). Uses the x86 SHA extensions when the
+// CPU has them and a portable scalar transform otherwise.
+#pragma once
+
+#include "sha_common.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace sha_detail {
+
+alignas(16) inline constexpr uint32_t K256[64] = {
+    0x428a2f98u,0x71374491u,0xb5c0fbcfu,0xe9b5dba5u,0x3956c25bu,0x59f111f1u,0x923f82a4u,0xab1c5ed5u,
+    0xd807aa98u,0x12835b01u,0x243185beu,0x550c7dc3u,0x72be5d74u,0x80deb1feu,0x9bdc06a7u,0xc19bf174u,
+    0xe49b69c1u,0xefbe4786u,0x0fc19dc6u,0x240ca1ccu,0x2de92c6fu,0x4a7484aau,0x5cb0a9dcu,0x76f988dau,
+    0x983e5152u,0xa831c66du,0xb00327c8u,0xbf597fc7u,0xc6e00bf3u,0xd5a79147u,0x06ca6351u,0x14292967u,
+    0x27b70a85u,0x2e1b2138u,0x4d2c6dfcu,0x53380d13u,0x650a7354u,0x766a0abbu,0x81c2c92eu,0x92722c85u,
+    0xa2bfe8a1u,0xa81a664bu,0xc24b8b70u,0xc76c51a3u,0xd192e819u,0xd6990624u,0xf40e3585u,0x106aa070u,
+    0x19a4c116u,0x1e376c08u,0x2748774cu,0x34b0bcb5u,0x391c0cb3u,0x4ed8aa4au,0x5b9cca4fu,0x682e6ff3u,
+    0x748f82eeu,0x78a5636fu,0x84c87814u,0x8cc70208u,0x90befffau,0xa4506cebu,0xbef9a3f7u,0xc67178f2u
+};
+
+inline void sha256_compress_scalar(uint32_t* st, const uint8_t* data, std::size_t nblocks) {
+    for (; nblocks > 0; --nblocks, data += 64) {
+        uint32_t W[64];
+        for (int i = 0; i < 16; ++i) W[i] = read_be32(data + 4*i);
+        for (int i = 16; i < 64; ++i) {
+            uint32_t s0 = rotr(W[i-15], 7) ^ rotr(W[i-15], 18) ^ (W[i-15] >> 3);
+            uint32_t s1 = rotr(W[i-2], 17) ^ rotr(W[i-2], 19) ^ (W[i-2] >> 10);
+            W[i] = W[i-16] + s0 + W[i-7] + s1;
+        }
+
+        uint32_t a = st[0], b = st[1], c = st[2], d = st[3];
+        uint32_t e = st[4], f = st[5], g = st[6], h = st[7];
+        for (int i = 0; i < 64; ++i) {
+            uint32_t S1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + S1 + ch + K256[i] + W[i];
+            uint32_t S0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = S0 + maj;
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        st[0] += a; st[1] += b; st[2] += c; st[3] += d;
+        st[4] += e; st[5] += f; st[6] += g; st[7] += h;
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// SHA-NI: the state lives as ABEF/CDGH halves across all blocks; each
+// sha256rnds2 does two rounds and msg1/msg2 extend the schedule 4 words at
+// a time.
+__attribute__((target("sha,sse4.1")))
+inline void sha256_compress_shani(uint32_t* st, const uint8_t* data, std::size_t nblocks) {
+    const __m128i MASK = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(st));
+    __m128i s1  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(st + 4));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);            // CDAB
+    s1  = _mm_shuffle_epi32(s1, 0x1B);             // EFGH
+    __m128i s0 = _mm_alignr_epi8(tmp, s1, 8);      // ABEF
+    s1 = _mm_blend_epi16(s1, tmp, 0xF0);           // CDGH
+
+    for (; nblocks > 0; --nblocks, data += 64) {
+        const __m128i abef = s0, cdgh = s1;
+        __m128i W[4];
+#pragma GCC unroll 16
+        for (int i = 0; i < 16; ++i) {
+            __m128i w;
+            if (i < 4) {
+                w = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16*i)), MASK);
+            } else {
+                w = _mm_sha256msg1_epu32(W[i & 3], W[(i + 1) & 3]);
+                w = _mm_add_epi32(w, _mm_alignr_epi8(W[(i + 3) & 3], W[(i + 2) & 3], 4));
+                w = _mm_sha256msg2_epu32(w, W[(i + 3) & 3]);
+            }
+            W[i & 3] = w;
+            __m128i msg = _mm_add_epi32(w, _mm_load_si128(reinterpret_cast<const __m128i*>(K256 + 4*i)));
+            s1 = _mm_sha256rnds2_epu32(s1, s0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            s0 = _mm_sha256rnds2_epu32(s0, s1, msg);
+        }
+        s0 = _mm_add_epi32(s0, abef);
+        s1 = _mm_add_epi32(s1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(s0, 0x1B);             // FEBA
+    s1  = _mm_shuffle_epi32(s1, 0xB1);             // DCHG
+    s0  = _mm_blend_epi16(tmp, s1, 0xF0);          // DCBA
+    s1  = _mm_alignr_epi8(s1, tmp, 8);             // ABEF
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(st), s0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(st + 4), s1);
+}
+#endif
+
+} // namespace sha_detail
+
+class SHA256 : public sha_detail::Hasher<SHA256, 8> {
+public:
+    static void init(uint32_t* st) {
+        static const uint32_t iv[8] = {
+            0x6a09e667u, 0xbb67ae85u, 0x3c6ef372u, 0xa54ff53au,
+            0x510e527fu, 0x9b05688cu, 0x1f83d9abu, 0x5be0cd19u
+        };
+        std::memcpy(st, iv, sizeof(iv));
+    }
+
+    static constexpr sha_detail::CompressFn compress_scalar = sha_detail::sha256_compress_scalar;
+#if defined(__x86_64__) || defined(__i386__)
+    static constexpr sha_detail::CompressFn compress_shani = sha_detail::sha256_compress_shani;
+#else
+    static constexpr sha_detail::CompressFn compress_shani = nullptr;
+#endif
+
+    static sha_detail::CompressFn compress() {
+        // has_sha_ni() is always false where compress_shani is not built
+        static const sha_detail::CompressFn fn =
+            sha_detail::has_sha_ni() ? compress_shani : compress_scalar;
+        return fn;
+    }
+};
@@ -0,0 +1,134 @@
+// Known-answer checks and throughput for the in-tree SHA1 / SHA256 classes.
+// Each block function (scalar, SHA-NI when the CPU has it) is timed
+// separately; build with -DHAVE_OPENSSL -lcrypto to add OpenSSL as a
+// reference column and cross-check every digest against it.
+
+#include "sha1.hpp"
+#include "sha256.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#ifdef HAVE_OPENSSL
+#include <openssl/evp.h>
+#endif
+
+// Digest through a specific block function, bypassing runtime dispatch
+template <typename H>
+static typename H::digest_type digest_with(sha_detail::CompressFn fn, const uint8_t* p, std::size_t len) {
+    uint32_t st[H::digest_size / 4];
+    H::init(st);
+    fn(st, p, len / 64);
+    uint8_t tail[128] = {};
+    std::size_t rem = len % 64;
+    std::memcpy(tail, p + len / 64 * 64, rem);
+    tail[rem] = 0x80;
+    std::size_t blocks = (rem < 56) ? 1 : 2;
+    uint64_t bits = static_cast<uint64_t>(len) * 8;
+    sha_detail::write_be32(tail + blocks * 64 - 8, static_cast<uint32_t>(bits >> 32));
+    sha_detail::write_be32(tail + blocks * 64 - 4, static_cast<uint32_t>(bits));
+    fn(st, tail, blocks);
+    typename H::digest_type out;
+    for (std::size_t i = 0; i < H::digest_size / 4; ++i) sha_detail::write_be32(out.data() + 4*i, st[i]);
+    return out;
+}
+
+#ifdef HAVE_OPENSSL
+template <typename H>
+static typename H::digest_type digest_openssl(const uint8_t* p, std::size_t len) {
+    typename H::digest_type out;
+    unsigned int n = 0;
+    EVP_Digest(p, len, out.data(), &n, H::digest_size == 32 ? EVP_sha256() : EVP_sha1(), nullptr);
+    return out;
+}
+#endif
+
+template <typename H>
+static bool check(const char* name, const char* const (&kat)[4][2]) {
+    bool ok = true;
+    for (const auto& t : kat) {
+        std::string msg = t[0];
+        if (msg == "<million a>") msg.assign(1000000, 'a');
+        bool good = H::hex(H::digest(msg)) == t[1];
+        ok = ok && good;
+        std::printf("%-6s %-12.12s %s\n", name, t[0], good ? "OK" : "**MISMATCH**");
+    }
+
+    // every block function (and OpenSSL) must agree on random lengths
+    std::mt19937 rng(455);
+    std::vector<uint8_t> buf(5000);
+    for (auto& b : buf) b = static_cast<uint8_t>(rng());
+    for (int i = 0; i < 500; ++i) {
+        std::size_t len = rng() % buf.size();
+        auto ref = digest_with<H>(H::compress_scalar, buf.data(), len);
+        bool same = H::digest(buf.data(), len) == ref;
+        if (sha_detail::has_sha_ni()) {
+            same = same && digest_with<H>(H::compress_shani, buf.data(), len) == ref;
+        }
+#ifdef HAVE_OPENSSL
+        same = same && digest_openssl<H>(buf.data(), len) == ref;
+#endif
+        if (!same) {
+            std::printf("%-6s cross-check **MISMATCH** at len %zu\n", name, len);
+            return false;
+        }
+    }
+    return ok;
+}
+
+template <typename F>
+static double gbps(F f, std::size_t len, std::size_t total) {
+    std::size_t reps = std::max<std::size_t>(1, total / std::max<std::size_t>(len, 1));
+    auto t0 = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < reps; ++i) f();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return reps * len / sec / 1e9;
+}
+
+template <typename H>
+static void bench(const char* name, std::size_t total) {
+    std::vector<uint8_t> buf(1u << 20, 0x5a);
+    volatile uint8_t sink = 0;
+    for (std::size_t len : {64u, 1024u, 16384u, 1u << 20}) {
+        double scalar = gbps([&] { sink = sink + digest_with<H>(H::compress_scalar, buf.data(), len)[0]; }, len, total);
+        std::printf("%-6s %8zu  scalar %6.3f GB/s", name, len, scalar);
+        if (sha_detail::has_sha_ni()) {
+            double ni = gbps([&] { sink = sink + digest_with<H>(H::compress_shani, buf.data(), len)[0]; }, len, total);
+            std::printf("  sha-ni %6.3f GB/s", ni);
+        }
+#ifdef HAVE_OPENSSL
+        double ossl = gbps([&] { sink = sink + digest_openssl<H>(buf.data(), len)[0]; }, len, total);
+        std::printf("  openssl %6.3f GB/s", ossl);
+#endif
+        std::printf("\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::size_t total = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : (256u << 20);
+
+    static const char* const kat256[4][2] = {
+        {"", "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+        {"abc", "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"},
+        {"<million a>", "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"}
+    };
+    static const char* const kat1[4][2] = {
+        {"", "da39a3ee5e6b4b0d3255bfef95601890afd80709"},
+        {"abc", "a9993e364706816aba3e25717850c26c9cd0d89d"},
+        {"abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+         "84983e441c3bd26ebaae4aa1f95129e5e54670f1"},
+        {"<million a>", "34aa973cd4c4daa4f61eeb2bdbad27316534016f"}
+    };
+
+    bool ok = check<SHA256>("sha256", kat256) & check<SHA1>("sha1", kat1);
+    std::printf("sha-ni: %s\n", sha_detail::has_sha_ni() ? "available" : "not available");
+    if (!ok) return 1;
+
+    bench<SHA256>("sha256", total);
+    bench<SHA1>("sha1", total);
+    return 0;
+}
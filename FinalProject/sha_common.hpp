@@ -0,0 +1,137 @@
+// sha_common.hpp — public domain / CC0
+// Incremental buffering, padding and CPU detection shared by SHA1 and SHA256.
+// Both use 64-byte blocks and a big-endian 64-bit bit length, so the hashers
+// only differ in their state size and block compression function.
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string>
+#include <cstring>
+
+namespace sha_detail {
+
+inline uint32_t read_be32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24)
+         | ((uint32_t)p[1] << 16)
+         | ((uint32_t)p[2] << 8)
+         |  (uint32_t)p[3];
+}
+inline void write_be32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)((v >> 24) & 0xFFu);
+    p[1] = (uint8_t)((v >> 16) & 0xFFu);
+    p[2] = (uint8_t)((v >> 8) & 0xFFu);
+    p[3] = (uint8_t)(v & 0xFFu);
+}
+
+inline uint32_t rotl(uint32_t v, uint32_t s) { return (v << s) | (v >> (32 - s)); }
+inline uint32_t rotr(uint32_t v, uint32_t s) { return (v >> s) | (v << (32 - s)); }
+
+// SHA extensions (plus the SSSE3/SSE4.1 shuffles the SHA-NI paths use)
+inline bool has_sha_ni() {
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+#else
+    return false;
+#endif
+}
+
+// Block compression: nblocks consecutive 64-byte blocks into state
+typedef void (*CompressFn)(uint32_t* state, const uint8_t* data, std::size_t nblocks);
+
+// Incremental hasher shared by SHA1 and SHA256 (CRTP). Words is the state
+// and digest size in 32-bit words; Impl provides
+//   static void init(uint32_t* state);
+//   static CompressFn compress();          // selected once at runtime
+//   static const CompressFn compress_scalar;
+template <typename Impl, std::size_t Words>
+class Hasher {
+public:
+    static constexpr std::size_t digest_size = Words * 4;
+    using digest_type = std::array<uint8_t, digest_size>;
+
+    Hasher() { reset(); }
+
+    void reset() {
+        Impl::init(state_);
+        total_len_ = 0;
+        buffer_len_ = 0;
+    }
+
+    void update(const void* data, std::size_t len) {
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        total_len_ += len;
+
+        if (buffer_len_ > 0) {
+            std::size_t to_copy = (len < (64 - buffer_len_)) ? len : (64 - buffer_len_);
+            std::memcpy(buffer_ + buffer_len_, p, to_copy);
+            buffer_len_ += to_copy;
+            p += to_copy;
+            len -= to_copy;
+            if (buffer_len_ == 64) {
+                compress_(state_, buffer_, 1);
+                buffer_len_ = 0;
+            }
+        }
+
+        // all full blocks in one call so accelerated paths keep state in registers
+        if (len >= 64) {
+            compress_(state_, p, len / 64);
+            p += len / 64 * 64;
+            len %= 64;
+        }
+
+        if (len > 0) {
+            std::memcpy(buffer_, p, len);
+            buffer_len_ = len;
+        }
+    }
+
+    // Finalize and return the digest; object is left ready to be reused
+    digest_type finalize() {
+        uint64_t bit_len = total_len_ * 8ULL;
+        uint8_t block[128];
+        std::memcpy(block, buffer_, buffer_len_);
+        block[buffer_len_] = 0x80;
+        std::size_t blocks = (buffer_len_ < 56) ? 1 : 2;
+        std::memset(block + buffer_len_ + 1, 0, blocks * 64 - 8 - buffer_len_ - 1);
+        write_be32(block + blocks * 64 - 8, static_cast<uint32_t>(bit_len >> 32));
+        write_be32(block + blocks * 64 - 4, static_cast<uint32_t>(bit_len));
+        compress_(state_, block, blocks);
+
+        digest_type out{};
+        for (std::size_t i = 0; i < Words; ++i) write_be32(out.data() + 4*i, state_[i]);
+        reset();
+        return out;
+    }
+
+    static digest_type digest(const void* data, std::size_t len) {
+        Impl h; h.update(data, len); return h.finalize();
+    }
+    static digest_type digest(const std::string& s) {
+        return digest(s.data(), s.size());
+    }
+    static std::string hex(const digest_type& d) {
+        static const char* hexd = "0123456789abcdef";
+        std::string s; s.resize(2 * digest_size);
+        for (std::size_t i = 0; i < digest_size; ++i) {
+            s[2*i]   = hexd[(d[i] >> 4) & 0xF];
+            s[2*i+1] = hexd[d[i] & 0xF];
+        }
+        return s;
+    }
+
+    // True when the SHA-NI block function is in use
+    static bool accelerated() { return Impl::compress() != Impl::compress_scalar; }
+
+private:
+    CompressFn compress_ = Impl::compress();
+    uint32_t state_[Words];
+    uint64_t total_len_;
+    uint8_t  buffer_[64];
+    std::size_t buffer_len_;
+};
+
+} // namespace sha_detail
@@ -0,0 +1,86 @@
+// Async spawn rate for different capture sizes.
+//
+//   async_spawn [workers] [tasks]
+//
+// Each column captures a payload of the given number of bytes next to a
+// counter pointer. "silent" submits executor.silent_async from the main
+// thread, "async" submits executor.async and keeps the futures, and
+// "runtime" spawns from inside a task with Runtime::silent_async and coruns.
+// Captures that fit the inline storage of the task callable
+// (TF_DEFAULT_SMALL_FUNCTION_INLINE_SIZE bytes) need no allocation besides
+// the task node itself.
+#include <taskflow/taskflow.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+template <typename F>
+double rate(size_t n, F&& f) {
+  auto beg = std::chrono::steady_clock::now();
+  f();
+  return n / std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count() / 1e6;
+}
+
+template <size_t S>
+void row(tf::Executor& executor, size_t tasks) {
+
+  std::atomic<size_t> counter {0};
+  std::array<char, S> payload {};
+  payload[0] = 1;
+
+  auto work = [c=&counter, payload](){
+    c->fetch_add(payload[0], std::memory_order_relaxed);
+  };
+
+  double silent = rate(tasks, [&](){
+    for(size_t i=0; i<tasks; ++i) {
+      executor.silent_async(work);
+    }
+    executor.wait_for_all();
+  });
+
+  std::vector<std::future<void>> futures;
+  futures.reserve(tasks);
+  double async = rate(tasks, [&](){
+    for(size_t i=0; i<tasks; ++i) {
+      futures.push_back(executor.async(work));
+    }
+    for(auto& fu : futures) {
+      fu.get();
+    }
+  });
+
+  double runtime = rate(tasks, [&](){
+    executor.async([&](tf::Runtime& rt){
+      for(size_t i=0; i<tasks; ++i) {
+        rt.silent_async(work);
+      }
+      rt.corun();
+    }).get();
+  });
+
+  if(counter != 3*tasks) {
+    std::fprintf(stderr, "lost tasks: %zu of %zu\n", counter.load(), 3*tasks);
+    std::exit(1);
+  }
+
+  std::printf("%8zu %10.2f %10.2f %10.2f\n", sizeof(work), silent, async, runtime);
+}
+
+int main(int argc, char* argv[]) {
+  size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+  size_t tasks = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+  tf::Executor executor(workers);
+
+  std::printf("%zu workers, %zu tasks (Mtasks/s)\n", workers, tasks);
+  std::printf("%8s %10s %10s %10s\n", "capture", "silent", "async", "runtime");
+  row<8>(executor, tasks);
+  row<24>(executor, tasks);
+  row<40>(executor, tasks);
+  row<96>(executor, tasks);
+  return 0;
+}
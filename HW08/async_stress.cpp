@@ -0,0 +1,89 @@
+// Long-running async stress test: node allocation rate and memory.
+//
+//   async_stress [workers] [seconds]
+//
+// Each round, the main thread submits a batch of silent_async tasks that
+// each spawn a child from their worker, plus a chain of dependent-async
+// tasks whose handles the main thread drops afterwards, so nodes are
+// allocated and freed by the main thread, by their own worker and by
+// other workers. Every second the test prints the number of task nodes
+// allocated per second and the resident set size. Build with
+// -DTF_DISABLE_NODE_ARENA to compare the executor's node arena against
+// plain new/delete.
+#include <taskflow/taskflow.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+
+// resident set size in MB, read from /proc (0 where it is unavailable)
+double rss() {
+  size_t pages = 0, resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> pages >> resident;
+  return resident * static_cast<double>(sysconf(_SC_PAGESIZE)) / (1 << 20);
+}
+
+int main(int argc, char* argv[]) {
+  size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+  size_t seconds = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10;
+
+  constexpr size_t batch = 4096;
+  constexpr size_t chain = 256;
+
+  tf::Executor executor(workers);
+  std::atomic<size_t> counter {0};
+  std::vector<tf::AsyncTask> handles(chain);
+
+#ifdef TF_DISABLE_NODE_ARENA
+  const char* mode = "new/delete";
+#else
+  const char* mode = "node arena";
+#endif
+
+  std::printf("%zu workers, %s\n", workers, mode);
+  std::printf("%8s %14s %10s\n", "second", "Mnodes/s", "RSS(MB)");
+
+  auto beg = std::chrono::steady_clock::now();
+  auto last = beg;
+  size_t nodes = 0;
+
+  for(size_t s=1; s<=seconds; ) {
+
+    for(size_t i=0; i<batch; ++i) {
+      executor.silent_async([&](){
+        counter.fetch_add(1, std::memory_order_relaxed);
+        executor.silent_async([&](){
+          counter.fetch_add(1, std::memory_order_relaxed);
+        });
+      });
+    }
+
+    handles[0] = executor.silent_dependent_async([&](){
+      counter.fetch_add(1, std::memory_order_relaxed);
+    });
+    for(size_t i=1; i<chain; ++i) {
+      handles[i] = executor.silent_dependent_async([&](){
+        counter.fetch_add(1, std::memory_order_relaxed);
+      }, handles[i-1]);
+    }
+
+    executor.wait_for_all();
+    handles.assign(chain, tf::AsyncTask());
+    nodes += 2*batch + chain;
+
+    if(auto now = std::chrono::steady_clock::now(); now - beg >= std::chrono::seconds(s)) {
+      double elapsed = std::chrono::duration<double>(now - last).count();
+      std::printf("%8zu %14.2f %10.1f\n", s, nodes / elapsed / 1e6, rss());
+      std::fflush(stdout);
+      last = now;
+      nodes = 0;
+      ++s;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+// Task throughput on fine-grained DAGs.
+//
+//   dag_throughput [workers] [runs]
+//
+// Every task is an empty static task, so the rate measures pure scheduling:
+// reading a node, running its callable and releasing its successors.
+//   chain     : 65536 tasks in a line
+//   tree      : binary in-tree (reduction) of depth 16
+//   wavefront : 256x256 grid, each cell after its left and upper neighbours
+//   random    : 64 layers of 1024 tasks, each with 4 random predecessors
+//               in the previous layer
+#include <taskflow/taskflow.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+void chain(tf::Taskflow& tf) {
+  auto prev = tf.emplace([](){});
+  for(size_t i=1; i<65536; ++i) {
+    auto t = tf.emplace([](){});
+    prev.precede(t);
+    prev = t;
+  }
+}
+
+void tree(tf::Taskflow& tf) {
+  std::vector<tf::Task> level(1 << 15);
+  for(auto& t : level) {
+    t = tf.emplace([](){});
+  }
+  while(level.size() > 1) {
+    std::vector<tf::Task> next(level.size() / 2);
+    for(size_t i=0; i<next.size(); ++i) {
+      next[i] = tf.emplace([](){});
+      level[2*i].precede(next[i]);
+      level[2*i+1].precede(next[i]);
+    }
+    level = std::move(next);
+  }
+}
+
+void wavefront(tf::Taskflow& tf) {
+  const size_t N = 256;
+  std::vector<tf::Task> grid(N*N);
+  for(size_t i=0; i<N; ++i) {
+    for(size_t j=0; j<N; ++j) {
+      grid[i*N+j] = tf.emplace([](){});
+      if(i > 0) grid[(i-1)*N+j].precede(grid[i*N+j]);
+      if(j > 0) grid[i*N+j-1].precede(grid[i*N+j]);
+    }
+  }
+}
+
+void random_dag(tf::Taskflow& tf) {
+  const size_t L = 64, W = 1024;
+  std::mt19937 rng(455);
+  std::uniform_int_distribution<size_t> pick(0, W-1);
+  std::vector<tf::Task> prev, curr;
+  for(size_t l=0; l<L; ++l) {
+    curr.clear();
+    for(size_t w=0; w<W; ++w) {
+      auto t = tf.emplace([](){});
+      for(size_t k=0; k<4 && !prev.empty(); ++k) {
+        prev[pick(rng)].precede(t);
+      }
+      curr.push_back(t);
+    }
+    prev.swap(curr);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+  size_t runs = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+  tf::Executor executor(workers);
+
+  std::printf("%zu workers, %zu runs, %zu-byte nodes (Mtasks/s)\n", workers, runs, sizeof(tf::Node));
+  std::printf("%10s %8s %10s\n", "dag", "tasks", "rate");
+
+  std::pair<const char*, void(*)(tf::Taskflow&)> dags[] = {
+    {"chain", chain}, {"tree", tree}, {"wavefront", wavefront}, {"random", random_dag}
+  };
+
+  for(auto& [name, build] : dags) {
+    tf::Taskflow taskflow;
+    build(taskflow);
+    executor.run(taskflow).wait();  // warm-up
+    auto beg = std::chrono::steady_clock::now();
+    executor.run_n(taskflow, runs).wait();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+    std::printf("%10s %8zu %10.2f\n", name, taskflow.num_tasks(), taskflow.num_tasks() * runs / s / 1e6);
+  }
+  return 0;
+}
@@ -0,0 +1,93 @@
+// Elastic executor under a bursty load.
+//
+//   elastic_bench [max_workers] [min_workers] [bursts]
+//
+// The main thread alternates between bursts of 200 ms, in which it keeps
+// about 4*max_workers tasks of 20 us each in flight, and idle gaps of
+// 200 ms. Every 10 ms it prints the number of active workers and the task
+// throughput of the last 10 ms, so the timeline shows how fast the
+// executor grows into a burst and gives the workers back afterwards.
+// The resize statistics of tf::ElasticStats follow at the end.
+#include <taskflow/taskflow.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace std::chrono_literals;
+
+void spin(std::chrono::microseconds d) {
+  auto end = std::chrono::steady_clock::now() + d;
+  while(std::chrono::steady_clock::now() < end);
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency();
+  size_t min_workers = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1;
+  size_t bursts = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 3;
+
+  tf::ElasticPolicy policy;
+  policy.min_workers = min_workers;
+  policy.max_workers = max_workers;
+
+  tf::Executor executor(policy);
+
+  std::atomic<size_t> done {0};
+  size_t submitted = 0;
+  const size_t in_flight = 4 * max_workers;
+
+  std::printf("%zu-%zu workers, %zu bursts\n", min_workers, max_workers, bursts);
+  std::printf("%8s %6s %8s %12s\n", "ms", "phase", "active", "Ktasks/s");
+
+  auto beg = std::chrono::steady_clock::now();
+  auto tick = beg;
+  size_t last_done = 0;
+
+  auto sample = [&](const char* phase){
+    auto now = std::chrono::steady_clock::now();
+    if(now - tick < 10ms) {
+      return;
+    }
+    size_t d = done.load(std::memory_order_relaxed);
+    std::printf("%8.0f %6s %8zu %12.1f\n",
+      std::chrono::duration<double, std::milli>(now - beg).count(), phase,
+      executor.num_active_workers(),
+      (d - last_done) / std::chrono::duration<double>(now - tick).count() / 1e3
+    );
+    last_done = d;
+    tick = now;
+  };
+
+  for(size_t b=0; b<bursts; ++b) {
+
+    auto end = std::chrono::steady_clock::now() + 200ms;
+    while(std::chrono::steady_clock::now() < end) {
+      while(submitted - done.load(std::memory_order_relaxed) < in_flight) {
+        executor.silent_async([&](){
+          spin(20us);
+          done.fetch_add(1, std::memory_order_relaxed);
+        });
+        ++submitted;
+      }
+      sample("burst");
+      std::this_thread::sleep_for(100us);
+    }
+
+    executor.wait_for_all();
+
+    end = std::chrono::steady_clock::now() + 200ms;
+    while(std::chrono::steady_clock::now() < end) {
+      sample("idle");
+      std::this_thread::sleep_for(1ms);
+    }
+  }
+
+  auto s = executor.elastic_stats();
+  auto us = [](std::chrono::nanoseconds d){ return d.count() / 1e3; };
+  std::printf("grows %zu (avg %.1f us, max %.1f us), shrinks %zu (avg %.1f us, max %.1f us)\n",
+    s.num_grows, s.num_grows ? us(s.grow_latency) / s.num_grows : 0.0, us(s.max_grow_latency),
+    s.num_shrinks, s.num_shrinks ? us(s.shrink_latency) / s.num_shrinks : 0.0, us(s.max_shrink_latency)
+  );
+  return 0;
+}
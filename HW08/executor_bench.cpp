@@ -0,0 +1,241 @@
+// Executor benchmark suite with JSON output.
+//
+//   executor_bench [max_workers] [reps] [output.json]
+//
+// Runs every case below on executors of 1, 2, 4, ... workers up to
+// max_workers (and max_workers itself), reps timed repetitions each after
+// one warm-up. Graphs are built once, outside the timed region, and all
+// tasks are empty, so the numbers measure the scheduler alone:
+//   async        : 65536 executor.async, then get every future
+//   silent_async : 65536 executor.silent_async, then wait_for_all
+//   chain        : 65536 tasks in a line
+//   binary_tree  : binary in-tree (reduction) of depth 16
+//   fan_out_in   : one source, 65536 middle tasks, one sink
+//   random_dag   : 64 layers of 1024 tasks with 4 random predecessors each
+//   subflow      : binary tree of nested subflows of depth 14
+//   corun_fib    : fib(22), each call spawning fib(n-1) and coruning
+//   run_n        : a 16-task diamond run 2048 times with run_n
+// Each result reports the median, minimum and maximum time per repetition
+// and the task rate at the median. The JSON goes to output.json, or to
+// stdout when no file is given; progress goes to stderr.
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+
+struct Case {
+  const char* name;
+  size_t tasks;
+  std::function<void(tf::Executor&)> run;
+};
+
+// keeps the taskflows of the graph cases alive across all executors
+std::vector<std::unique_ptr<tf::Taskflow>> taskflows;
+
+tf::Taskflow& make_taskflow() {
+  return *taskflows.emplace_back(std::make_unique<tf::Taskflow>());
+}
+
+Case graph_case(const char* name, std::function<void(tf::Taskflow&)> build) {
+  auto& tf = make_taskflow();
+  build(tf);
+  return {name, tf.num_tasks(), [&tf](tf::Executor& executor){ executor.run(tf).wait(); }};
+}
+
+void chain(tf::Taskflow& tf) {
+  auto prev = tf.emplace([](){});
+  for(size_t i=1; i<65536; ++i) {
+    auto t = tf.emplace([](){});
+    prev.precede(t);
+    prev = t;
+  }
+}
+
+void binary_tree(tf::Taskflow& tf) {
+  std::vector<tf::Task> level(1 << 15);
+  for(auto& t : level) {
+    t = tf.emplace([](){});
+  }
+  while(level.size() > 1) {
+    std::vector<tf::Task> next(level.size() / 2);
+    for(size_t i=0; i<next.size(); ++i) {
+      next[i] = tf.emplace([](){});
+      level[2*i].precede(next[i]);
+      level[2*i+1].precede(next[i]);
+    }
+    level = std::move(next);
+  }
+}
+
+void fan_out_in(tf::Taskflow& tf) {
+  auto src = tf.emplace([](){});
+  auto dst = tf.emplace([](){});
+  for(size_t i=0; i<65536; ++i) {
+    auto t = tf.emplace([](){});
+    src.precede(t);
+    t.precede(dst);
+  }
+}
+
+void random_dag(tf::Taskflow& tf) {
+  const size_t L = 64, W = 1024;
+  std::mt19937 rng(455);
+  std::uniform_int_distribution<size_t> pick(0, W-1);
+  std::vector<tf::Task> prev, curr;
+  for(size_t l=0; l<L; ++l) {
+    curr.clear();
+    for(size_t w=0; w<W; ++w) {
+      auto t = tf.emplace([](){});
+      for(size_t k=0; k<4 && !prev.empty(); ++k) {
+        prev[pick(rng)].precede(t);
+      }
+      curr.push_back(t);
+    }
+    prev.swap(curr);
+  }
+}
+
+void nested(tf::Subflow& sf, size_t depth) {
+  if(depth == 0) {
+    return;
+  }
+  sf.emplace([depth](tf::Subflow& sf){ nested(sf, depth-1); });
+  sf.emplace([depth](tf::Subflow& sf){ nested(sf, depth-1); });
+}
+
+size_t fib(tf::Runtime& rt, size_t n) {
+  if(n < 2) {
+    return n;
+  }
+  size_t a = 0;
+  rt.silent_async([&a, n](tf::Runtime& rt){ a = fib(rt, n-1); });
+  size_t b = fib(rt, n-2);
+  rt.corun();
+  return a + b;
+}
+
+// number of tasks fib spawns
+size_t fib_tasks(size_t n) {
+  return n < 2 ? 0 : 1 + fib_tasks(n-1) + fib_tasks(n-2);
+}
+
+std::vector<Case> make_cases() {
+
+  std::vector<Case> cases;
+
+  const size_t N = 65536;
+
+  cases.push_back({"async", N, [N](tf::Executor& executor){
+    std::vector<std::future<void>> futures;
+    futures.reserve(N);
+    for(size_t i=0; i<N; ++i) {
+      futures.push_back(executor.async([](){}));
+    }
+    for(auto& fu : futures) {
+      fu.get();
+    }
+  }});
+
+  cases.push_back({"silent_async", N, [N](tf::Executor& executor){
+    for(size_t i=0; i<N; ++i) {
+      executor.silent_async([](){});
+    }
+    executor.wait_for_all();
+  }});
+
+  cases.push_back(graph_case("chain", chain));
+  cases.push_back(graph_case("binary_tree", binary_tree));
+  cases.push_back(graph_case("fan_out_in", fan_out_in));
+  cases.push_back(graph_case("random_dag", random_dag));
+
+  cases.push_back(graph_case("subflow", [](tf::Taskflow& tf){
+    tf.emplace([](tf::Subflow& sf){ nested(sf, 14); });
+  }));
+  cases.back().tasks = (size_t{1} << 15) - 1;
+
+  cases.push_back({"corun_fib", fib_tasks(22) + 1, [](tf::Executor& executor){
+    executor.async([](tf::Runtime& rt){ fib(rt, 22); }).get();
+  }});
+
+  auto& diamond = make_taskflow();
+  auto src = diamond.emplace([](){});
+  auto dst = diamond.emplace([](){});
+  for(size_t i=0; i<14; ++i) {
+    auto t = diamond.emplace([](){});
+    src.precede(t);
+    t.precede(dst);
+  }
+  cases.push_back({"run_n", diamond.num_tasks() * 2048, [&diamond](tf::Executor& executor){
+    executor.run_n(diamond, 2048).wait();
+  }});
+
+  return cases;
+}
+
+int main(int argc, char* argv[]) {
+  size_t max_workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency();
+  size_t reps = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10;
+  FILE* out = (argc > 3) ? std::fopen(argv[3], "w") : stdout;
+
+  if(max_workers == 0 || reps == 0 || out == nullptr) {
+    std::fprintf(stderr, "usage: executor_bench [max_workers > 0] [reps > 0] [output.json]\n");
+    return 1;
+  }
+
+  std::vector<size_t> sweep;
+  for(size_t w=1; w<max_workers; w*=2) {
+    sweep.push_back(w);
+  }
+  sweep.push_back(max_workers);
+
+  auto cases = make_cases();
+
+  std::fprintf(out, "{\n");
+  std::fprintf(out, "  \"taskflow_version\": \"%d.%d.%d\",\n",
+    TF_MAJOR_VERSION, TF_MINOR_VERSION, TF_PATCH_VERSION);
+  std::fprintf(out, "  \"hardware_concurrency\": %u,\n", std::thread::hardware_concurrency());
+  std::fprintf(out, "  \"reps\": %zu,\n", reps);
+  std::fprintf(out, "  \"results\": [");
+
+  bool first = true;
+
+  for(auto workers : sweep) {
+
+    tf::Executor executor(workers);
+
+    for(auto& c : cases) {
+
+      c.run(executor);  // warm-up
+
+      std::vector<double> ms(reps);
+      for(auto& t : ms) {
+        auto beg = std::chrono::steady_clock::now();
+        c.run(executor);
+        t = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg).count();
+      }
+      std::sort(ms.begin(), ms.end());
+      double median = ms[reps/2];
+
+      std::fprintf(stderr, "%2zu workers %14s %10.3f ms\n", workers, c.name, median);
+      std::fprintf(out, "%s\n    {\"name\": \"%s\", \"workers\": %zu, \"tasks\": %zu, "
+        "\"median_ms\": %.4f, \"min_ms\": %.4f, \"max_ms\": %.4f, \"mtasks_per_s\": %.3f}",
+        first ? "" : ",", c.name, workers, c.tasks,
+        median, ms.front(), ms.back(), c.tasks / median / 1e3
+      );
+      first = false;
+    }
+  }
+
+  std::fprintf(out, "\n  ]\n}\n");
+
+  if(out != stdout) {
+    std::fclose(out);
+  }
+  return 0;
+}
@@ -0,0 +1,60 @@
+// Wide fan-out scheduling throughput.
+//
+//   fanout_bench [workers] [tasks_per_width]
+//
+// "static": a source task releases `width` empty successors that all feed
+// one sink, and the taskflow is run repeatedly with run_n.
+// "subflow": a subflow spawns `width` empty tasks and joins them.
+// Both cases are dominated by pushing ready tasks into the worker queue and
+// waking thieves, which is what bulk push and notify_n amortize.
+#include <taskflow/taskflow.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+template <typename F>
+double seconds(F&& f) {
+  auto beg = std::chrono::steady_clock::now();
+  f();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+}
+
+int main(int argc, char* argv[]) {
+  size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+  size_t total = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4000000;
+
+  tf::Executor executor(workers);
+
+  std::printf("%zu workers, ~%zu tasks per width (Mtasks/s)\n", workers, total);
+  std::printf("%8s %10s %10s\n", "width", "static", "subflow");
+
+  for(size_t width=16; width<=16384; width*=4) {
+    size_t runs = std::max<size_t>(1, total / width);
+
+    tf::Taskflow fanout;
+    auto source = fanout.emplace([](){});
+    auto sink = fanout.emplace([](){});
+    for(size_t i=0; i<width; ++i) {
+      auto t = fanout.emplace([](){});
+      source.precede(t);
+      t.precede(sink);
+    }
+
+    tf::Taskflow spawner;
+    spawner.emplace([width](tf::Subflow& sf){
+      for(size_t i=0; i<width; ++i) {
+        sf.emplace([](){});
+      }
+    });
+
+    executor.run(fanout).wait();  // warm-up
+    double s1 = seconds([&](){ executor.run_n(fanout, runs).wait(); });
+    double s2 = seconds([&](){ executor.run_n(spawner, runs).wait(); });
+
+    std::printf("%8zu %10.2f %10.2f\n", width,
+      (width + 2) * runs / s1 / 1e6, (width + 1) * runs / s2 / 1e6);
+  }
+  return 0;
+}
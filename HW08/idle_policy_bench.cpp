@@ -0,0 +1,86 @@
+// Idle policy trade-off on a bursty workload.
+//
+//   idle_policy_bench [workers] [gap_us] [bursts]
+//
+// Each burst runs a taskflow of 4*workers small tasks and then the main
+// thread sleeps for gap_us microseconds. For every tf::IdlePolicy preset the
+// table reports the burst latency (submit to completion), the CPU time the
+// process burned per second of wall time, and how the workers' idle time was
+// split between spinning, yielding and sleeping.
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/resource.h>
+
+double cpu_seconds() {
+  rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec +
+         (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+double ms(std::chrono::nanoseconds d) {
+  return d.count() / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+  size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+  size_t gap_us = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 500;
+  size_t bursts = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 2000;
+
+  std::pair<const char*, tf::IdlePolicy> presets[] = {
+    {"latency",    tf::IdlePolicy::latency()},
+    {"balanced",   tf::IdlePolicy::balanced()},
+    {"power-save", tf::IdlePolicy::power_save()},
+    {"adaptive",   tf::IdlePolicy::adaptive_backoff()}
+  };
+
+  std::printf("%zu workers, %zu bursts of %zu tasks, %zu us apart\n",
+              workers, bursts, 4*workers, gap_us);
+  std::printf("%10s %9s %9s %9s %9s %9s %9s %7s\n", "policy", "p50(us)", "p99(us)",
+              "cpu/wall", "spin(ms)", "yield(ms)", "sleep(ms)", "sleeps");
+
+  for(auto& [name, policy] : presets) {
+
+    tf::Executor executor(workers);
+    executor.set_idle_policy(policy);
+
+    tf::Taskflow taskflow;
+    for(size_t i=0; i<4*workers; ++i) {
+      taskflow.emplace([](){
+        volatile size_t x = 0;
+        for(size_t k=0; k<2000; ++k) {
+          x = x + k;
+        }
+      });
+    }
+    executor.run(taskflow).wait();  // warm-up
+
+    std::vector<double> latency(bursts);
+    auto wall_beg = std::chrono::steady_clock::now();
+    auto cpu_beg = cpu_seconds();
+
+    for(size_t b=0; b<bursts; ++b) {
+      auto beg = std::chrono::steady_clock::now();
+      executor.run(taskflow).wait();
+      latency[b] = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - beg
+      ).count();
+      std::this_thread::sleep_for(std::chrono::microseconds(gap_us));
+    }
+
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_beg).count();
+    double cpu = cpu_seconds() - cpu_beg;
+    auto stats = executor.idle_stats();
+
+    std::sort(latency.begin(), latency.end());
+    std::printf("%10s %9.1f %9.1f %9.2f %9.1f %9.1f %9.1f %7zu\n", name,
+      latency[bursts/2], latency[bursts*99/100], cpu / wall,
+      ms(stats.spin), ms(stats.yield), ms(stats.sleep), stats.num_sleeps);
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+// Cost of the always-on executor metrics.
+//
+//   metrics_bench [num_workers] [rounds]
+//
+// Runs two fine-grained workloads, rounds times each:
+//   dag   : 64 layers of 1024 empty tasks, each with 4 random predecessors
+//   async : 65536 empty silent_async tasks spawned from the main thread
+// and prints the median time per round. Build it once as is and once with
+// -DTF_DISABLE_METRICS to compare; the metrics build then prints the
+// executor's counters and task-duration histograms in Prometheus text.
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+template <typename F>
+double median_ms(size_t rounds, F&& f) {
+  std::vector<double> ms(rounds);
+  for(auto& t : ms) {
+    auto beg = std::chrono::steady_clock::now();
+    f();
+    t = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg).count();
+  }
+  std::sort(ms.begin(), ms.end());
+  return ms[rounds/2];
+}
+
+int main(int argc, char* argv[]) {
+  size_t num_workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency();
+  size_t rounds = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 20;
+
+  if(num_workers == 0 || rounds == 0) {
+    std::fprintf(stderr, "usage: metrics_bench [num_workers > 0] [rounds > 0]\n");
+    return 1;
+  }
+
+  tf::Executor executor(num_workers);
+
+  tf::Taskflow dag;
+  std::mt19937 rng(455);
+  std::uniform_int_distribution<size_t> pick(0, 1023);
+  std::vector<tf::Task> prev, curr;
+  for(size_t l=0; l<64; ++l) {
+    curr.clear();
+    for(size_t w=0; w<1024; ++w) {
+      auto t = dag.emplace([](){});
+      for(size_t k=0; k<4 && !prev.empty(); ++k) {
+        prev[pick(rng)].precede(t);
+      }
+      curr.push_back(t);
+    }
+    prev.swap(curr);
+  }
+
+#ifdef TF_DISABLE_METRICS
+  std::printf("metrics disabled, %zu workers, %zu rounds\n", num_workers, rounds);
+#else
+  std::printf("metrics enabled, %zu workers, %zu rounds\n", num_workers, rounds);
+#endif
+
+  double dag_ms = median_ms(rounds, [&](){ executor.run(dag).wait(); });
+  std::printf("%8s %10.3f ms %8.2f Mtasks/s\n", "dag", dag_ms, dag.num_tasks() / dag_ms / 1e3);
+
+  double async_ms = median_ms(rounds, [&](){
+    for(size_t i=0; i<65536; ++i) {
+      executor.silent_async([](){});
+    }
+    executor.wait_for_all();
+  });
+  std::printf("%8s %10.3f ms %8.2f Mtasks/s\n", "async", async_ms, 65536 / async_ms / 1e3);
+
+#ifndef TF_DISABLE_METRICS
+  std::printf("\n");
+  executor.metrics().dump_prometheus(std::cout);
+#endif
+
+  return 0;
+}
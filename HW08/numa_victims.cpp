@@ -0,0 +1,147 @@
+// Checks the locality tiers of the steal victims of a NUMA executor.
+//
+//   numa_victims
+//
+// Builds a fake sysfs of 2 NUMA nodes with 2 last-level-cache clusters of
+// 2 CPUs each, constructs an executor of 8 workers on it, and checks that
+// every worker k
+//   + never lists itself as a victim
+//   + has exactly its cluster mates as its cluster-tier victims
+//   + has the rest of its domain and the domain's buffers next
+// It also checks that discovery keeps only the CPUs of a given cpuset.
+// Workers that could not be bound to their CPUs (e.g., CPUs this machine
+// does not have) are marked as unbound, which is not a violation.
+// Prints each worker's victims and exits with 1 on the first violation.
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+
+namespace fs = std::filesystem;
+
+void write(const fs::path& path, const std::string& line) {
+  fs::create_directories(path.parent_path());
+  std::ofstream(path) << line << '\n';
+}
+
+// node n holds CPUs [4n, 4n+4); CPUs 2c and 2c+1 share a last-level cache
+fs::path make_sysfs() {
+  auto root = fs::temp_directory_path() / "numa_victims_sysfs";
+  fs::remove_all(root);
+  write(root / "node/possible", "0-1");
+  write(root / "node/node0/cpulist", "0-3");
+  write(root / "node/node1/cpulist", "4-7");
+  for(int c=0; c<8; ++c) {
+    auto cache = root / ("cpu/cpu" + std::to_string(c)) / "cache/index0";
+    write(cache / "level", "3");
+    write(cache / "shared_cpu_list", std::to_string(c & ~1) + "-" + std::to_string(c | 1));
+  }
+  return root;
+}
+
+struct Recorder : public tf::WorkerInterface {
+
+  std::mutex mutex;
+  std::vector<std::vector<size_t>> victims = std::vector<std::vector<size_t>>(8);
+  std::vector<std::pair<size_t, size_t>> tiers = std::vector<std::pair<size_t, size_t>>(8);
+  std::vector<bool> bound = std::vector<bool>(8);
+
+  void scheduler_prologue(tf::Worker& w) override {
+    std::scoped_lock lock(mutex);
+    victims[w.id()] = w.victims();
+    tiers[w.id()] = {w.num_cluster_victims(), w.num_domain_victims()};
+    bound[w.id()] = !w.cpus().empty();
+  }
+
+  void scheduler_epilogue(tf::Worker&, std::exception_ptr) override {}
+};
+
+int main() {
+
+  const size_t W = 8;
+
+  auto root = make_sysfs();
+  std::vector<int> all {0, 1, 2, 3, 4, 5, 6, 7};
+  auto numa = tf::NumaTopology::discover(root.string(), all);
+
+  // a cpuset keeps only its CPUs and drops nodes it does not cover
+  auto cpuset = tf::NumaTopology::discover(root.string(), {0, 1, 3});
+  fs::remove_all(root);
+
+  if(cpuset.num_nodes() != 1 || cpuset.nodes()[0].cpus != std::vector<int>{0, 1, 3} ||
+     cpuset.nodes()[0].clusters != std::vector<size_t>{0, 0, 1}) {
+    std::fprintf(stderr, "cpuset not applied to the topology\n");
+    return 1;
+  }
+
+  if(numa.num_nodes() != 2 || numa.num_cpus() != W) {
+    std::fprintf(stderr, "unexpected topology: %zu nodes, %zu cpus\n", numa.num_nodes(), numa.num_cpus());
+    return 1;
+  }
+
+  auto recorder = std::make_shared<Recorder>();
+  {
+    tf::Executor executor(W, numa, recorder);
+  }
+
+  int failures = 0;
+
+  for(size_t k=0; k<W; ++k) {
+
+    auto& v = recorder->victims[k];
+    auto [nc, nd] = recorder->tiers[k];
+
+    std::printf("worker %zu: victims [", k);
+    for(size_t i=0; i<v.size(); ++i) {
+      std::printf("%s%zu%s", i ? " " : "", v[i], (i+1 == nc || i+1 == nd) ? " |" : "");
+    }
+    std::printf("]%s\n", recorder->bound[k] ? "" : " (unbound)");
+
+    // workers of a node get consecutive ids and fill its two clusters in order
+    std::set<size_t> mates, domain;
+    for(size_t i=0; i<W; ++i) {
+      if(i != k && i / 4 == k / 4) {
+        (i / 2 == k / 2 ? mates : domain).insert(i);
+      }
+    }
+
+    // worker ids of each tier; larger queue ids are buffers
+    auto workers = [&](size_t b, size_t e) {
+      std::multiset<size_t> ids;
+      std::copy_if(v.begin() + b, v.begin() + e, std::inserter(ids, ids.end()),
+                   [&](size_t q){ return q < W; });
+      return ids;
+    };
+
+    auto check = [&](bool ok, const char* what) {
+      if(!ok) {
+        std::fprintf(stderr, "worker %zu: %s\n", k, what);
+        ++failures;
+      }
+    };
+
+    check(std::find(v.begin(), v.end(), k) == v.end(), "lists itself as a victim");
+    check(
+      workers(0, nc) == std::multiset<size_t>(mates.begin(), mates.end()) &&
+      nc == mates.size(),
+      "cluster-tier victims are not its cluster mates"
+    );
+    check(
+      workers(nc, nd) == std::multiset<size_t>(domain.begin(), domain.end()),
+      "domain-tier victims are not the rest of its domain"
+    );
+    check(workers(0, v.size()).size() == W - 1, "victims do not cover every other worker once");
+  }
+
+  if(failures) {
+    return 1;
+  }
+
+  std::printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,109 @@
+// Throughput of tf::Pipeline versus the batch size of its pipes.
+//
+//   pipeline_batch [num_workers] [num_tokens]
+//
+// Runs a packet-style pipeline of four pipes, each doing about 100 ns of
+// work per token:
+//   0 serial   : generates num_tokens tokens (batch size of one)
+//   1 parallel : computes a value per token
+//   2 serial   : checks the tokens arrive in order and accumulates the values
+//   3 parallel : computes a second value per token
+// on 2 x num_workers lines, with pipes 1-3 batched by 1, 2, 4, ..., 256
+// tokens, and reports the wall time, the tokens per second, and the
+// speedup over unbatched pipes. Every run checks the serial pipe saw each
+// token once and in order.
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/pipeline.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// about 100 ns of dependent arithmetic
+inline uint64_t work(uint64_t x) {
+  for(int i=0; i<80; ++i) {
+    x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+  }
+  return x;
+}
+
+int main(int argc, char* argv[]) {
+  size_t num_workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency();
+  size_t num_tokens = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : (1 << 20);
+
+  if(num_workers == 0 || num_tokens == 0) {
+    std::fprintf(stderr, "usage: pipeline_batch [num_workers > 0] [num_tokens > 0]\n");
+    return 1;
+  }
+
+  const size_t num_lines = 2 * num_workers;
+
+  tf::Executor executor(num_workers);
+
+  std::printf("%zu workers, %zu lines, %zu tokens, 4 pipes\n", num_workers, num_lines, num_tokens);
+  std::printf("%8s %12s %14s %10s\n", "batch", "time (ms)", "Mtokens/s", "speedup");
+
+  double base = 0;
+
+  for(size_t batch = 1; batch <= 256; batch *= 2) {
+
+    // one slot per token a line carries; a line's span never crosses a
+    // multiple of the batch size
+    std::vector<std::vector<uint64_t>> buffer(num_lines, std::vector<uint64_t>(batch));
+    size_t expected = 0;
+    uint64_t sum = 0;
+
+    tf::Pipeline pipeline(num_lines,
+      tf::Pipe{tf::PipeType::SERIAL, [&](tf::Pipeflow& pf) {
+        if(pf.token() == num_tokens) {
+          pf.stop();
+        }
+        else {
+          buffer[pf.line()][pf.token() % batch] = pf.token();
+        }
+      }},
+      tf::Pipe{tf::PipeType::PARALLEL, batch, [&](tf::Pipeflow& pf) {
+        for(size_t t=pf.token(); t<pf.token()+pf.num_tokens(); t++) {
+          auto& v = buffer[pf.line()][t % batch];
+          v = work(v);
+        }
+      }},
+      tf::Pipe{tf::PipeType::SERIAL, batch, [&](tf::Pipeflow& pf) {
+        for(size_t t=pf.token(); t<pf.token()+pf.num_tokens(); t++) {
+          if(t != expected++) {
+            std::fprintf(stderr, "batch %zu: token %zu out of order\n", batch, t);
+            std::exit(1);
+          }
+          sum += work(buffer[pf.line()][t % batch]);
+        }
+      }},
+      tf::Pipe{tf::PipeType::PARALLEL, batch, [&](tf::Pipeflow& pf) {
+        for(size_t t=pf.token(); t<pf.token()+pf.num_tokens(); t++) {
+          auto& v = buffer[pf.line()][t % batch];
+          v = work(v);
+        }
+      }}
+    );
+
+    tf::Taskflow taskflow;
+    taskflow.composed_of(pipeline);
+
+    auto beg = std::chrono::steady_clock::now();
+    executor.run(taskflow).wait();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg).count();
+
+    if(expected != num_tokens || pipeline.num_tokens() != num_tokens) {
+      std::fprintf(stderr, "batch %zu: %zu of %zu tokens\n", batch, expected, num_tokens);
+      return 1;
+    }
+
+    if(base == 0) {
+      base = ms;
+    }
+
+    std::printf("%8zu %12.3f %14.3f %10.2f\n", batch, ms, num_tokens / ms / 1e3, base / ms);
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+// Checks that a batched tf::Pipeline resumes correctly after a stop.
+//
+//   pipeline_rerun [num_workers]
+//
+// Runs a pipeline of three pipes on 3 lines:
+//   0 serial   : stops at the present token limit (batch size of one)
+//   1 parallel : batched by B
+//   2 serial   : records the tokens it sees
+// with token limits 10, 13, 20, 21, 21, and 32 in turn, rerunning the same
+// taskflow after each stop, for B = 1, 2, 3, and 4. Every run must
+//   + process exactly the tokens up to its limit, in order
+//   + invoke the first pipe once per token plus once for the stop
+//   + never hand pipe 1 a span that crosses a multiple of B
+// Exits with 1 on the first violation.
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/pipeline.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char* argv[]) {
+  size_t num_workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                                  : std::thread::hardware_concurrency();
+
+  if(num_workers == 0) {
+    std::fprintf(stderr, "usage: pipeline_rerun [num_workers > 0]\n");
+    return 1;
+  }
+
+  const size_t num_lines = 3;
+  const std::vector<size_t> limits {10, 13, 20, 21, 21, 32};
+
+  tf::Executor executor(num_workers);
+
+  for(size_t batch = 1; batch <= 4; ++batch) {
+
+    size_t limit = 0;
+    size_t calls = 0;
+    std::atomic<bool> crossed {false};
+    std::vector<size_t> seen;
+
+    tf::Pipeline pipeline(num_lines,
+      tf::Pipe{tf::PipeType::SERIAL, [&](tf::Pipeflow& pf) {
+        ++calls;
+        if(pf.token() == limit) {
+          pf.stop();
+        }
+      }},
+      tf::Pipe{tf::PipeType::PARALLEL, batch, [&](tf::Pipeflow& pf) {
+        if(pf.token() / batch != (pf.token() + pf.num_tokens() - 1) / batch) {
+          crossed = true;
+        }
+      }},
+      tf::Pipe{tf::PipeType::SERIAL, [&](tf::Pipeflow& pf) {
+        seen.push_back(pf.token());
+      }}
+    );
+
+    tf::Taskflow taskflow;
+    taskflow.composed_of(pipeline);
+
+    size_t expected = 0;
+
+    for(auto l : limits) {
+
+      limit = l;
+      calls = 0;
+      size_t before = expected;
+
+      executor.run(taskflow).wait();
+
+      for(; expected < limit; ++expected) {
+        if(expected >= seen.size() || seen[expected] != expected) {
+          break;
+        }
+      }
+
+      bool ok = expected == limit && seen.size() == limit &&
+                pipeline.num_tokens() == limit &&
+                calls == limit - before + 1 && !crossed;
+
+      std::printf("batch %zu, limit %2zu: %2zu tokens, %2zu first-pipe calls%s\n",
+        batch, limit, seen.size() - before, calls, ok ? "" : "  <- wrong");
+
+      if(!ok) {
+        return 1;
+      }
+    }
+  }
+
+  std::printf("ok\n");
+  return 0;
+}
@@ -0,0 +1,86 @@
+// Tail latency of high-priority tasks under saturating low-priority load.
+//
+//   priority_latency [workers] [probes] [task_us]
+//
+// A background taskflow of 8*workers independent LOW tasks, each spinning
+// for task_us microseconds, runs over and over and keeps every worker busy.
+// Meanwhile the main thread submits `probes` async tasks, one every 200 us,
+// and records how long each waits between submission and the start of its
+// execution. The probes are submitted once as LOW, competing with the
+// background on equal terms, and once as HIGH.
+#include <taskflow/taskflow.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using clock_type = std::chrono::steady_clock;
+
+void spin_for(std::chrono::microseconds us) {
+  auto end = clock_type::now() + us;
+  while(clock_type::now() < end);
+}
+
+std::vector<double> probe(
+  tf::Executor& executor, size_t probes, size_t task_us, tf::TaskPriority priority
+) {
+  std::atomic<bool> stop {false};
+
+  tf::Taskflow background;
+  for(size_t i=0; i<8*executor.num_workers(); ++i) {
+    background.emplace([task_us](){ spin_for(std::chrono::microseconds(task_us)); })
+              .priority(tf::TaskPriority::LOW);
+  }
+  auto bg = executor.run_until(background, [&](){ return stop.load(); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));  // saturate
+
+  std::vector<double> latency(probes);
+  std::atomic<size_t> done {0};
+  tf::TaskParams params;
+  params.priority = priority;
+
+  for(size_t i=0; i<probes; ++i) {
+    auto submitted = clock_type::now();
+    executor.silent_async(params, [&, i, submitted](){
+      latency[i] = std::chrono::duration<double, std::micro>(clock_type::now() - submitted).count();
+      done.fetch_add(1, std::memory_order_release);
+    });
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+  }
+
+  while(done.load(std::memory_order_acquire) != probes) {
+    std::this_thread::yield();
+  }
+  stop = true;
+  bg.wait();
+
+  std::sort(latency.begin(), latency.end());
+  return latency;
+}
+
+int main(int argc, char* argv[]) {
+  size_t workers = (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+  size_t probes = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000;
+  size_t task_us = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 50;
+
+  tf::Executor executor(workers);
+
+  std::printf("%zu workers, %zu probes, %zu us background tasks (latency in us)\n",
+              workers, probes, task_us);
+  std::printf("%6s %10s %10s %10s %10s\n", "probe", "p50", "p99", "p99.9", "max");
+
+  std::pair<const char*, tf::TaskPriority> modes[] = {
+    {"LOW",  tf::TaskPriority::LOW},
+    {"HIGH", tf::TaskPriority::HIGH}
+  };
+
+  for(auto& [name, priority] : modes) {
+    auto l = probe(executor, probes, task_us, priority);
+    std::printf("%6s %10.1f %10.1f %10.1f %10.1f\n", name,
+      l[probes/2], l[probes*99/100], l[probes*999/1000], l.back());
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+// Submit throughput from threads outside the executor, for 1 to 64 producers.
+//
+//   submit_throughput [tasks_per_producer] [workers]
+//
+// "freelist" pushes pointers straight into the executor's external
+// submission queue (tf::Freelist) while `workers` threads steal them, and
+// compares it with "locked", a copy of the previous design that takes a
+// bucket mutex on every push. "executor" measures the end-to-end rate of
+// executor.silent_async from the producers until wait_for_all returns.
+#include <taskflow/taskflow.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// the previous Freelist: a mutex per bucket around an UnboundedTaskQueue
+class LockedFreelist {
+  struct Bucket {
+    std::mutex mutex;
+    tf::UnboundedTaskQueue<int*> queue;
+  };
+  std::vector<Bucket> _buckets;
+
+public:
+  LockedFreelist(size_t N) : _buckets(N < 4 ? 1 : tf::floor_log2(N)) {}
+  void push(int* item) {
+    auto b = (reinterpret_cast<uintptr_t>(item) >> 16) % _buckets.size();
+    std::scoped_lock lock(_buckets[b].mutex);
+    _buckets[b].queue.push(item);
+  }
+  int* steal(size_t b) { return _buckets[b].queue.steal(); }
+  size_t size() const { return _buckets.size(); }
+};
+
+template <typename Q>
+double queue_rate(size_t producers, size_t per_producer, size_t consumers) {
+  Q q(consumers);
+  std::vector<int> items(per_producer);
+  std::atomic<size_t> taken {0};
+  const size_t total = producers * per_producer;
+
+  auto beg = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for(size_t c=0; c<consumers; ++c) {
+    threads.emplace_back([&, c](){
+      for(size_t b=c%q.size(); taken.load(std::memory_order_relaxed) < total; b=(b+1)%q.size()) {
+        if(q.steal(b)) {
+          taken.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for(size_t p=0; p<producers; ++p) {
+    threads.emplace_back([&](){
+      for(size_t i=0; i<per_producer; ++i) {
+        q.push(&items[i]);
+      }
+    });
+  }
+  for(auto& t : threads) {
+    t.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return total / std::chrono::duration<double>(end - beg).count();
+}
+
+double executor_rate(tf::Executor& executor, size_t producers, size_t per_producer) {
+  std::atomic<size_t> ran {0};
+  auto beg = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for(size_t p=0; p<producers; ++p) {
+    threads.emplace_back([&](){
+      for(size_t i=0; i<per_producer; ++i) {
+        executor.silent_async([&](){ ran.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+  for(auto& t : threads) {
+    t.join();
+  }
+  executor.wait_for_all();
+  auto end = std::chrono::steady_clock::now();
+  if(ran != producers * per_producer) {
+    std::fprintf(stderr, "lost tasks: %zu of %zu\n", ran.load(), producers * per_producer);
+    std::exit(1);
+  }
+  return ran / std::chrono::duration<double>(end - beg).count();
+}
+
+int main(int argc, char* argv[]) {
+  size_t per_producer = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100000;
+  size_t workers = (argc > 2) ? std::strtoull(argv[2], nullptr, 10)
+                              : std::thread::hardware_concurrency();
+
+  tf::Executor executor(workers);
+
+  std::printf("%zu workers, %zu tasks per producer (Mtasks/s)\n", workers, per_producer);
+  std::printf("%9s %10s %10s %10s\n", "producers", "locked", "freelist", "executor");
+  for(size_t p=1; p<=64; p*=2) {
+    double locked = queue_rate<LockedFreelist>(p, per_producer, workers);
+    double lockfree = queue_rate<tf::Freelist<int*>>(p, per_producer, workers);
+    double async = executor_rate(executor, p, per_producer);
+    std::printf("%9zu %10.2f %10.2f %10.2f\n", p, locked / 1e6, lockfree / 1e6, async / 1e6);
+  }
+  return 0;
+}
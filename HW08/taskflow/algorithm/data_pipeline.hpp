@@ -47,6 +47,20 @@ tf::make_data_pipe<int, std::string>(
 );
 @endcode
 
+Instead of returning its output, your callable can write it in place
+through a reference to the output slot, which turns the pipeline into
+typed mode (see tf::DataPipeline::typed_slots):
+
+@code{.cpp}
+tf::make_data_pipe<std::vector<float>, std::vector<float>>(
+  tf::PipeType::PARALLEL, 
+  [](std::vector<float>& input, std::vector<float>& output) {
+    output.resize(input.size());    // reuses the capacity of the slot
+    std::transform(input.begin(), input.end(), output.begin(), f);
+  }
+);
+@endcode
+
 */
 template <typename Input, typename Output, typename C>
 class DataPipe {
@@ -172,6 +186,34 @@ auto make_data_pipe(PipeType d, C&& callable) {
   return DataPipe<Input, Output, C>(d, std::forward<C>(callable));
 }
 
+// Function: data_pipe_in_place
+// Queries whether the data pipe writes its output through a reference,
+// i.e., (output_t&, tf::Pipeflow&) for the first pipe, and
+// (input_t&, output_t&) or (input_t&, output_t&, tf::Pipeflow&) for the others
+/** @private */
+template <typename P, bool First>
+constexpr bool data_pipe_in_place() {
+  using callable_t = typename P::callable_t;
+  using input_t    = std::add_lvalue_reference_t<std::decay_t<typename P::input_t>>;
+  using output_t   = std::add_lvalue_reference_t<std::decay_t<typename P::output_t>>;
+  if constexpr (std::is_void_v<typename P::output_t>) {
+    return false;
+  }
+  else if constexpr (First) {
+    return !std::is_invocable_v<callable_t, Pipeflow&> &&
+            std::is_invocable_v<callable_t, output_t, Pipeflow&>;
+  }
+  else if constexpr (std::is_void_v<typename P::input_t>) {
+    return false;
+  }
+  else {
+    return !std::is_invocable_v<callable_t, input_t> &&
+           !std::is_invocable_v<callable_t, input_t, Pipeflow&> &&
+           (std::is_invocable_v<callable_t, input_t, output_t> ||
+            std::is_invocable_v<callable_t, input_t, output_t, Pipeflow&>);
+  }
+}
+
 // ----------------------------------------------------------------------------
 // Class Definition: DataPipeline
 // ----------------------------------------------------------------------------
@@ -269,6 +311,15 @@ class DataPipeline {
     PipeType type;
   };
 
+  /**
+  @private
+  */
+  template <typename P>
+  using slot_t = std::conditional_t<
+    std::is_void_v<typename P::output_t>, 
+    std::monostate, 
+    std::decay_t<typename P::output_t>
+  >;
 
   public:
   
@@ -281,6 +332,40 @@ class DataPipeline {
     std::decay_t<typename Ps::output_t>>...
   >>;
 
+  /**
+  @brief whether the pipeline stores the output of each pipe in its own
+         slot array of the exact output type
+
+  By default, each line keeps one tf::DataPipeline::data_t, a std::variant
+  of all output types, which every pipe reads with @c std::get and
+  overwrites with its return value.
+  A pipeline switches to typed mode when any of its pipes writes its
+  output in place, i.e., its callable takes a reference to the output
+  instead of returning it (see tf::DataPipe).
+  In typed mode, the pipeline preallocates, for every pipe, one
+  default-constructed slot of its output type per line; a pipe receives a
+  reference to the slot of the previous pipe on its line as its input, and
+  either writes its own slot through a reference or assigns its return
+  value to it.
+  A slot keeps its value until the next token on the same line overwrites
+  it, so a payload can reuse the memory it owns (e.g., the capacity of a
+  vector) from token to token without any allocation or copy.
+
+  Typed mode is not always faster.
+  A line holds the outputs of all pipes at once, so its footprint is the
+  sum of the output sizes rather than the largest one, and the slots of
+  all lines stay live for the whole run.
+  Payloads that own heap memory gain little when the allocator already
+  recycles their blocks, and payloads stored inline (e.g., a large
+  std::array) have nothing to reuse, so the larger footprint can make
+  typed mode slower than the variant buffer.
+  Prefer typed mode for payloads that are expensive to construct or move,
+  and measure inline payloads before switching.
+  */
+  static constexpr bool typed_slots = 
+    data_pipe_in_place<std::tuple_element_t<0, std::tuple<Ps...>>, true>() ||
+    (data_pipe_in_place<Ps, false>() || ...);
+
   /**
   @brief constructs a data-parallel pipeline object
 
@@ -363,11 +448,18 @@ class DataPipeline {
   std::vector<Pipeflow> _pipeflows;
   std::vector<CachelineAligned<data_t>> _buffer;
 
+  // typed mode: one slot array per pipe, indexed by line
+  std::tuple<std::vector<CachelineAligned<slot_t<Ps>>>...> _slots;
+
   template <size_t... I>
   auto _gen_meta(std::tuple<Ps...>&&, std::index_sequence<I...>);
 
   void _on_pipe(Pipeflow&, Runtime&);
   void _build();
+  void _alloc_slots();
+
+  template <size_t I = 0>
+  void _on_slot(Pipeflow&);
 };
 
 // constructor
@@ -378,7 +470,7 @@ DataPipeline<Ps...>::DataPipeline(size_t num_lines, Ps&&... ps) :
   _lines     (num_lines),
   _tasks     (num_lines + 1),
   _pipeflows (num_lines),
-  _buffer    (num_lines) {
+  _buffer    (typed_slots ? 0 : num_lines) {
 
   if(num_lines == 0) {
     TF_THROW("must have at least one line");
@@ -388,6 +480,7 @@ DataPipeline<Ps...>::DataPipeline(size_t num_lines, Ps&&... ps) :
     TF_THROW("first pipe must be serial");
   }
 
+  _alloc_slots();
   reset();
   _build();
 }
@@ -402,7 +495,7 @@ DataPipeline<Ps...>::DataPipeline(size_t num_lines, std::tuple<Ps...>&& ps) :
   _lines     (num_lines),
   _tasks     (num_lines + 1),
   _pipeflows (num_lines),
-  _buffer    (num_lines) {
+  _buffer    (typed_slots ? 0 : num_lines) {
 
   if(num_lines == 0) {
     TF_THROW("must have at least one line");
@@ -412,6 +505,7 @@ DataPipeline<Ps...>::DataPipeline(size_t num_lines, std::tuple<Ps...>&& ps) :
     TF_THROW("first pipe must be serial");
   }
 
+  _alloc_slots();
   reset();
   _build();
 }
@@ -423,6 +517,23 @@ auto DataPipeline<Ps...>::_gen_meta(std::tuple<Ps...>&& ps, std::index_sequence<
   return std::array{PipeMeta{std::get<I>(ps).type()}...};
 }
 
+// Procedure: _alloc_slots
+template <typename... Ps>
+void DataPipeline<Ps...>::_alloc_slots() {
+  if constexpr (typed_slots) {
+    std::apply([this](auto&... slots){
+      ([&](auto& slot){
+        using value_t = typename std::decay_t<decltype(slot)>::value_type;
+        static_assert(
+          std::is_default_constructible_v<decltype(value_t::data)>,
+          "output types of a typed data pipeline must be default-constructible"
+        );
+        slot.resize(num_lines());
+      }(slots), ...);
+    }, _slots);
+  }
+}
+
 // Function: num_lines
 template <typename... Ps>
 size_t DataPipeline<Ps...>::num_lines() const noexcept {
@@ -483,54 +594,140 @@ void DataPipeline<Ps...>::reset() {
 template <typename... Ps>
 void DataPipeline<Ps...>::_on_pipe(Pipeflow& pf, Runtime&) {
 
-  visit_tuple([&](auto&& pipe){
+  if constexpr (typed_slots) {
+    _on_slot(pf);
+  }
+  else {
+    visit_tuple([&](auto&& pipe){
 
-    using data_pipe_t = std::decay_t<decltype(pipe)>;
-    using callable_t  = typename data_pipe_t::callable_t;
-    using input_t     = std::decay_t<typename data_pipe_t::input_t>;
-    using output_t    = std::decay_t<typename data_pipe_t::output_t>;
+      using data_pipe_t = std::decay_t<decltype(pipe)>;
+      using callable_t  = typename data_pipe_t::callable_t;
+      using input_t     = std::decay_t<typename data_pipe_t::input_t>;
+      using output_t    = std::decay_t<typename data_pipe_t::output_t>;
     
-    // first pipe
-    if constexpr (std::is_invocable_v<callable_t, Pipeflow&>) {
-      // [](tf::Pipeflow&) -> void {}, i.e., we only have one pipe
-      if constexpr (std::is_void_v<output_t>) {
-        pipe._callable(pf);
-      // [](tf::Pipeflow&) -> output_t {}
-      } else {
-        _buffer[pf._line].data = pipe._callable(pf);
+      // first pipe
+      if constexpr (std::is_invocable_v<callable_t, Pipeflow&>) {
+        // [](tf::Pipeflow&) -> void {}, i.e., we only have one pipe
+        if constexpr (std::is_void_v<output_t>) {
+          pipe._callable(pf);
+        // [](tf::Pipeflow&) -> output_t {}
+        } else {
+          _buffer[pf._line].data = pipe._callable(pf);
+        }
       }
+      // other pipes without pipeflow in the second argument
+      else if constexpr (std::is_invocable_v<callable_t, std::add_lvalue_reference_t<input_t> >) {
+        // [](input_t&) -> void {}, i.e., the last pipe
+        if constexpr (std::is_void_v<output_t>) {
+          pipe._callable(std::get<input_t>(_buffer[pf._line].data));
+        // [](input_t&) -> output_t {}
+        } else {
+          _buffer[pf._line].data = pipe._callable(
+            std::get<input_t>(_buffer[pf._line].data)
+          );
+        }
+      }
+      // other pipes with pipeflow in the second argument
+      else if constexpr (std::is_invocable_v<callable_t, input_t&, Pipeflow&>) {
+        // [](input_t&, tf::Pipeflow&) -> void {}
+        if constexpr (std::is_void_v<output_t>) {
+          pipe._callable(std::get<input_t>(_buffer[pf._line].data), pf);
+        // [](input_t&, tf::Pipeflow&) -> output_t {}
+        } else {
+          _buffer[pf._line].data = pipe._callable(
+            std::get<input_t>(_buffer[pf._line].data), pf
+          );
+        }
+      }
+      //else if constexpr(std::is_invocable_v<callable_t, Pipeflow&, Runtime&>) {
+      //  pipe._callable(pf, rt);
+      //}
+      else {
+        static_assert(dependent_false_v<callable_t>, "un-supported pipe callable type");
+      }
+    }, _pipes, pf._pipe);
+  }
+}
+
+// Procedure: _on_slot
+// Invokes the I-th pipe in typed mode, where its input is the slot of the
+// previous pipe and its output is its own slot on the same line
+template <typename... Ps>
+template <size_t I>
+void DataPipeline<Ps...>::_on_slot(Pipeflow& pf) {
+
+  if(pf._pipe != I) {
+    if constexpr (I + 1 < sizeof...(Ps)) {
+      _on_slot<I + 1>(pf);
+    }
+    return;
+  }
+
+  using data_pipe_t = std::tuple_element_t<I, std::tuple<Ps...>>;
+  using callable_t  = typename data_pipe_t::callable_t;
+  using input_t     = std::decay_t<typename data_pipe_t::input_t>;
+  using output_t    = std::decay_t<typename data_pipe_t::output_t>;
+
+  auto& pipe = std::get<I>(_pipes);
+
+  // first pipe
+  if constexpr (I == 0) {
+    // [](tf::Pipeflow&) -> void {}
+    if constexpr (std::is_void_v<output_t>) {
+      pipe._callable(pf);
+    }
+    // [](tf::Pipeflow&) -> output_t {}
+    else if constexpr (std::is_invocable_v<callable_t, Pipeflow&>) {
+      std::get<0>(_slots)[pf._line].data = pipe._callable(pf);
+    }
+    // [](output_t&, tf::Pipeflow&) -> void {}
+    else if constexpr (std::is_invocable_v<callable_t, output_t&, Pipeflow&>) {
+      pipe._callable(std::get<0>(_slots)[pf._line].data, pf);
+    }
+    else {
+      static_assert(dependent_false_v<callable_t>, "un-supported pipe callable type");
     }
-    // other pipes without pipeflow in the second argument
-    else if constexpr (std::is_invocable_v<callable_t, std::add_lvalue_reference_t<input_t> >) {
-      // [](input_t&) -> void {}, i.e., the last pipe
+  }
+  // other pipes
+  else {
+    using prev_output_t = std::decay_t<
+      typename std::tuple_element_t<I - 1, std::tuple<Ps...>>::output_t
+    >;
+    static_assert(
+      std::is_same_v<input_t, prev_output_t>,
+      "input type of a pipe must be the output type of its previous pipe"
+    );
+
+    auto& input = std::get<I - 1>(_slots)[pf._line].data;
+
+    // [](input_t&) -> void/output_t {}
+    if constexpr (std::is_invocable_v<callable_t, input_t&>) {
       if constexpr (std::is_void_v<output_t>) {
-        pipe._callable(std::get<input_t>(_buffer[pf._line].data));
-      // [](input_t&) -> output_t {}
+        pipe._callable(input);
       } else {
-        _buffer[pf._line].data = pipe._callable(
-          std::get<input_t>(_buffer[pf._line].data)
-        );
+        std::get<I>(_slots)[pf._line].data = pipe._callable(input);
       }
     }
-    // other pipes with pipeflow in the second argument
+    // [](input_t&, tf::Pipeflow&) -> void/output_t {}
     else if constexpr (std::is_invocable_v<callable_t, input_t&, Pipeflow&>) {
-      // [](input_t&, tf::Pipeflow&) -> void {}
       if constexpr (std::is_void_v<output_t>) {
-        pipe._callable(std::get<input_t>(_buffer[pf._line].data), pf);
-      // [](input_t&, tf::Pipeflow&) -> output_t {}
+        pipe._callable(input, pf);
       } else {
-        _buffer[pf._line].data = pipe._callable(
-          std::get<input_t>(_buffer[pf._line].data), pf
-        );
+        std::get<I>(_slots)[pf._line].data = pipe._callable(input, pf);
       }
     }
-    //else if constexpr(std::is_invocable_v<callable_t, Pipeflow&, Runtime&>) {
-    //  pipe._callable(pf, rt);
-    //}
+    // [](input_t&, output_t&) -> void {}
+    else if constexpr (std::is_invocable_v<callable_t, input_t&, std::add_lvalue_reference_t<output_t>>) {
+      pipe._callable(input, std::get<I>(_slots)[pf._line].data);
+    }
+    // [](input_t&, output_t&, tf::Pipeflow&) -> void {}
+    else if constexpr (std::is_invocable_v<callable_t, input_t&, std::add_lvalue_reference_t<output_t>, Pipeflow&>) {
+      pipe._callable(input, std::get<I>(_slots)[pf._line].data, pf);
+    }
     else {
       static_assert(dependent_false_v<callable_t>, "un-supported pipe callable type");
     }
-  }, _pipes, pf._pipe);
+  }
 }
 
 // Procedure: _build
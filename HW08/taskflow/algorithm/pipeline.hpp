@@ -133,11 +133,25 @@ class Pipeflow {
 
   /**
   @brief queries the token identifier
+
+  In a batched pipe, this is the first of the consecutive tokens the
+  invocation processes (see tf::Pipe::batch).
   */
   size_t token() const {
     return _token;
   }
 
+  /**
+  @brief queries the number of consecutive tokens, starting at token(),
+         the present invocation processes
+
+  The number is one except in a pipe with a batch size larger than one
+  (see tf::Pipe::batch).
+  */
+  size_t num_tokens() const {
+    return _num_tokens;
+  }
+
   /**
   @brief stops the pipeline scheduling
 
@@ -178,6 +192,11 @@ class Pipeflow {
   size_t _pipe;
   size_t _token;
   bool   _stop;
+
+  // Data field for batched tokens: the tokens in the present invocation
+  // and the tokens the line carries
+  size_t _num_tokens {1};
+  size_t _batch {1};
   
   // Data field for token dependencies
   size_t _num_deferrals; 
@@ -266,6 +285,28 @@ class Pipe {
     _type{d}, _callable{std::forward<C>(callable)} {
   }
 
+  /**
+  @brief constructs a batched pipe object
+
+  @param d pipe type (tf::PipeType)
+  @param batch maximum number of consecutive tokens per invocation
+  @param callable callable type
+
+  @code{.cpp}
+  Pipe{PipeType::PARALLEL, 64, [](tf::Pipeflow& pf){
+    for(size_t t=pf.token(); t<pf.token()+pf.num_tokens(); t++) {}
+  }}
+  @endcode
+
+  See tf::Pipe::batch for how a pipeline schedules batched pipes.
+  */
+  Pipe(PipeType d, size_t batch, C&& callable) :
+    _type{d}, _batch{batch}, _callable{std::forward<C>(callable)} {
+    if(batch == 0) {
+      TF_THROW("batch size must be positive");
+    }
+  }
+
   /**
   @brief queries the type of the pipe
 
@@ -297,10 +338,50 @@ class Pipe {
     _callable = std::forward<U>(callable);
   }
 
+  /**
+  @brief queries the batch size of the pipe
+  */
+  size_t batch() const {
+    return _batch;
+  }
+
+  /**
+  @brief assigns a new batch size to the pipe
+
+  @param batch maximum number of consecutive tokens per invocation
+
+  By default, a pipe processes one token per invocation, and every token
+  hops from pipe to pipe as a separate scheduling step.
+  When a pipe of a tf::Pipeline has a batch size larger than one, each
+  line of the pipeline carries up to @c B consecutive tokens per hop,
+  where @c B is the largest batch size of all pipes, and this pipe is
+  invoked once per span of up to @c batch tokens, as given by
+  tf::Pipeflow::token and tf::Pipeflow::num_tokens.
+  A serial pipe still sees the tokens in increasing order, and a line's
+  span never crosses a multiple of @c B (after a stop partway through a
+  span, the next run first fills up to the next multiple), so
+  <tt>pf.token() % B</tt> indexes a per-line buffer of @c B entries.
+  The first pipe must keep a batch size of one: it is invoked once per
+  token, up to @c B times in a row by the same line, so that it can stop
+  the pipeline at any token; once it stops, it is not invoked again in
+  the same run, while the line still carries the tokens it generated
+  before the stop.
+  Token deferral is not supported in a batched pipeline, and only
+  tf::Pipeline honors the batch size.
+  */
+  void batch(size_t batch) {
+    if(batch == 0) {
+      TF_THROW("batch size must be positive");
+    }
+    _batch = batch;
+  }
+
   private:
 
   PipeType _type;
 
+  size_t _batch {1};
+
   C _callable;
 };
 
@@ -417,6 +498,7 @@ class Pipeline {
   */
   struct PipeMeta {
     PipeType type;
+    size_t batch;
   };
 
   public:
@@ -500,6 +582,15 @@ class Pipeline {
   std::tuple<Ps...> _pipes;
   std::array<PipeMeta, sizeof...(Ps)> _meta;
   std::vector<std::array<Line, sizeof...(Ps)>> _lines;
+
+  // number of tokens a line carries per hop (the largest pipe batch size)
+  size_t _batch {1};
+
+  // batched mode: whether the first pipe stopped in the present run, and
+  // the line that returned on the stop, where the next run resumes
+  bool _stopped {false};
+  size_t _stop_line {0};
+
   std::vector<Task> _tasks;
   std::vector<Pipeflow> _pipeflows;
   
@@ -539,6 +630,7 @@ class Pipeline {
   auto _gen_meta(std::tuple<Ps...>&&, std::index_sequence<I...>);
 
   void _on_pipe(Pipeflow&, Runtime&);
+  void _on_batch(Pipeflow&, Runtime&);
   void _build();
   void _check_dependents(Pipeflow&);
   void _construct_deferred_tokens(Pipeflow&);
@@ -549,7 +641,7 @@ class Pipeline {
 template <typename... Ps>
 Pipeline<Ps...>::Pipeline(size_t num_lines, Ps&&... ps) :
   _pipes     {std::make_tuple(std::forward<Ps>(ps)...)},
-  _meta      {PipeMeta{ps.type()}...},
+  _meta      {PipeMeta{ps.type(), ps.batch()}...},
   _lines     (num_lines),
   _tasks     (num_lines + 1),
   _pipeflows (num_lines) {
@@ -562,6 +654,14 @@ Pipeline<Ps...>::Pipeline(size_t num_lines, Ps&&... ps) :
     TF_THROW("first pipe must be serial");
   }
 
+  if(_meta[0].batch != 1) {
+    TF_THROW("first pipe must have a batch size of one");
+  }
+
+  for(const auto& m : _meta) {
+    _batch = (std::max)(_batch, m.batch);
+  }
+
   reset();
   _build();
 }
@@ -585,6 +685,14 @@ Pipeline<Ps...>::Pipeline(size_t num_lines, std::tuple<Ps...>&& ps) :
     TF_THROW("first pipe must be serial");
   }
 
+  if(_meta[0].batch != 1) {
+    TF_THROW("first pipe must have a batch size of one");
+  }
+
+  for(const auto& m : _meta) {
+    _batch = (std::max)(_batch, m.batch);
+  }
+
   reset();
   _build();
 }
@@ -593,7 +701,7 @@ Pipeline<Ps...>::Pipeline(size_t num_lines, std::tuple<Ps...>&& ps) :
 template <typename... Ps>
 template <size_t... I>
 auto Pipeline<Ps...>::_gen_meta(std::tuple<Ps...>&& ps, std::index_sequence<I...>) {
-  return std::array{PipeMeta{std::get<I>(ps).type()}...};
+  return std::array{PipeMeta{std::get<I>(ps).type(), std::get<I>(ps).batch()}...};
 }
 
 // Function: num_lines
@@ -625,6 +733,8 @@ template <typename... Ps>
 void Pipeline<Ps...>::reset() {
 
   _num_tokens = 0;
+  _stopped = false;
+  _stop_line = 0;
 
   for(size_t l = 0; l<num_lines(); l++) {
     _pipeflows[l]._pipe = 0;
@@ -676,6 +786,22 @@ void Pipeline<Ps...>::_on_pipe(Pipeflow& pf, Runtime& rt) {
   }, _pipes, pf._pipe);
 }
 
+// Procedure: _on_batch
+// Invokes the present pipe over the tokens the line carries, in spans of
+// up to the pipe's batch size
+template <typename... Ps>
+void Pipeline<Ps...>::_on_batch(Pipeflow& pf, Runtime& rt) {
+  size_t first = pf._token;
+  size_t batch = _meta[pf._pipe].batch;
+  for(size_t i=0; i<pf._batch; i+=batch) {
+    pf._token = first + i;
+    pf._num_tokens = (std::min)(batch, pf._batch - i);
+    _on_pipe(pf, rt);
+  }
+  pf._token = first;
+  pf._num_tokens = 1;
+}
+
 // Procedure: _check_dependents
 // Check and remove invalid dependents after on_pipe
 // For example, users may defer a pipeflow to multiple tokens,
@@ -803,6 +929,12 @@ void Pipeline<Ps...>::_build() {
 
   // init task
   _tasks[0] = fb.emplace([this]() {
+    // a batched line carries several tokens, so resume at the line that
+    // returned on the last stop rather than at the line of the next token
+    if (_batch > 1) {
+      _stopped = false;
+      return static_cast<int>(_stop_line);
+    }
     return static_cast<int>(_num_tokens % num_lines());
   }).name("cond");
 
@@ -819,8 +951,37 @@ void Pipeline<Ps...>::_build() {
         static_cast<size_t>(_meta[pf->_pipe].type), std::memory_order_relaxed
       );
       
+      // First pipe of a batched pipeline generates up to _batch consecutive
+      // tokens, one invocation per token, without crossing a multiple of
+      // _batch; after a stop, the next line to reach it returns instead
+      if (pf->_pipe == 0 && _batch > 1) {
+        if (_stopped) {
+          _stop_line = pf->_line;
+          return;
+        }
+        size_t first = _num_tokens;
+        size_t limit = _batch - first % _batch;
+        pf->_num_deferrals = 0;
+        for(pf->_batch = 0; pf->_batch < limit; ++pf->_batch) {
+          pf->_token = _num_tokens;
+          if (pf->_stop = false, _on_pipe(*pf, rt); pf->_stop == true) {
+            _stopped = true;
+            break;
+          }
+          if (pf->_dependents.empty() == false) {
+            TF_THROW("token deferral is not supported in a batched pipeline");
+          }
+          ++_num_tokens;
+        }
+        // stopped at the first token
+        if (pf->_batch == 0) {
+          _stop_line = pf->_line;
+          return;
+        }
+        pf->_token = first;
+      }
       // First pipe does all jobs of initialization and token dependencies
-      if (pf->_pipe == 0) {
+      else if (pf->_pipe == 0) {
         // _ready_tokens queue is not empty
         // substitute pf with the token at the front of the queue
         if (!_ready_tokens.empty()) {
@@ -870,6 +1031,9 @@ void Pipeline<Ps...>::_build() {
           _resolve_token_dependencies(*pf); 
         }
       }
+      else if (_batch > 1) {
+        _on_batch(*pf, rt);
+      }
       else {
         _on_pipe(*pf, rt);
       }
@@ -16,6 +16,16 @@ TF_FORCE_INLINE void Executor::_schedule_async_task(Node* node) {
   (pt::this_worker) ? _schedule(*pt::this_worker, node) : _schedule(node);
 }
 
+// Function: _animate_async
+template <typename... ArgsT>
+TF_FORCE_INLINE Node* Executor::_animate_async(ArgsT&&... args) {
+#ifdef TF_DISABLE_NODE_ARENA
+  return animate(std::forward<ArgsT>(args)...);
+#else
+  return _node_arena->animate(std::forward<ArgsT>(args)...);
+#endif
+}
+
 // Procedure: _tear_down_async
 inline void Executor::_tear_down_async(Worker& worker, Node* node, Node*& cache) {
   
@@ -32,7 +42,7 @@ inline void Executor::_tear_down_async(Worker& worker, Node* node, Node*& cache)
       }
     }
   }
-  recycle(node);
+  recycle_async(node);
 }
 
 // ----------------------------------------------------------------------------
@@ -62,16 +72,16 @@ auto Executor::_async(P&& params, F&& f, Topology* tpg, Node* parent) {
     std::promise<void> p;
     auto fu{p.get_future()};
     
-    _schedule_async_task(animate(
+    _schedule_async_task(_animate_async(
       NSTATE::NONE, ESTATE::ANCHORED, std::forward<P>(params), tpg, parent, 0, 
       std::in_place_type_t<Node::Async>{}, 
-      [p=MoC{std::move(p)}, f=std::forward<F>(f)](Runtime& rt, bool reentered) mutable { 
+      [p=std::move(p), f=std::forward<F>(f)](Runtime& rt, bool reentered) mutable { 
         if(!reentered) {
           f(rt);
         }
         else {
-          auto& eptr = rt._parent->_exception_ptr;
-          eptr ? p.object.set_exception(eptr) : p.object.set_value();
+          auto eptr = rt._parent->_exception();
+          eptr ? p.set_exception(eptr) : p.set_value();
         }
       }
     ));
@@ -82,10 +92,10 @@ auto Executor::_async(P&& params, F&& f, Topology* tpg, Node* parent) {
     using R = std::invoke_result_t<F>;
     std::packaged_task<R()> p(std::forward<F>(f));
     auto fu{p.get_future()};
-    _schedule_async_task(animate(
+    _schedule_async_task(_animate_async(
       NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), tpg, parent, 0, 
       std::in_place_type_t<Node::Async>{}, 
-      [p=make_moc(std::move(p))]() mutable { p.object(); }
+      [p=std::move(p)]() mutable { p(); }
     ));
     return fu;
   }
@@ -121,7 +131,7 @@ template <typename P, typename F>
 void Executor::_silent_async(P&& params, F&& f, Topology* tpg, Node* parent) {
   // silent task 
   if constexpr (is_runtime_task_v<F> || is_static_task_v<F>) {
-    _schedule_async_task(animate(
+    _schedule_async_task(_animate_async(
       NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), tpg, parent, 0,
       std::in_place_type_t<Node::Async>{}, std::forward<F>(f)
     ));
@@ -183,7 +193,7 @@ tf::AsyncTask Executor::silent_dependent_async(
 
   size_t num_dependents = std::distance(first, last);
   
-  AsyncTask task(animate(
+  AsyncTask task(_animate_async(
     NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), nullptr, nullptr, num_dependents,
     std::in_place_type_t<Node::DependentAsync>{}, std::forward<F>(func)
   ));
@@ -246,16 +256,16 @@ auto Executor::dependent_async(P&& params, F&& func, I first, I last) {
     std::promise<void> p;
     auto fu{p.get_future()};
 
-    AsyncTask task(animate(
+    AsyncTask task(_animate_async(
       NSTATE::NONE, ESTATE::ANCHORED, std::forward<P>(params), nullptr, nullptr, num_dependents,
       std::in_place_type_t<Node::DependentAsync>{},
-      [p=MoC{std::move(p)}, f=std::forward<F>(func)] (tf::Runtime& rt, bool reentered) mutable { 
+      [p=std::move(p), f=std::forward<F>(func)] (tf::Runtime& rt, bool reentered) mutable { 
         if(!reentered) {
           f(rt); 
         }
         else {
-          auto& eptr = rt._parent->_exception_ptr;
-          eptr ? p.object.set_exception(eptr) : p.object.set_value();
+          auto eptr = rt._parent->_exception();
+          eptr ? p.set_exception(eptr) : p.set_value();
         }
       }
     ));
@@ -277,10 +287,10 @@ auto Executor::dependent_async(P&& params, F&& func, I first, I last) {
     std::packaged_task<R()> p(std::forward<F>(func));
     auto fu{p.get_future()};
 
-    AsyncTask task(animate(
+    AsyncTask task(_animate_async(
       NSTATE::NONE, ESTATE::NONE, std::forward<P>(params), nullptr, nullptr, num_dependents,
       std::in_place_type_t<Node::DependentAsync>{},
-      [p=make_moc(std::move(p))] () mutable { p.object(); }
+      [p=std::move(p)] () mutable { p(); }
     ));
 
     for(; first != last; first++) {
@@ -357,7 +367,7 @@ inline void Executor::_tear_down_dependent_async(Worker& worker, Node* node, Nod
   
   // now the executor no longer needs to retain ownership
   if(handle->use_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-    recycle(node);
+    recycle_async(node);
   }
 
   _decrement_topology();
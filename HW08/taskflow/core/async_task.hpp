@@ -1,6 +1,7 @@
 #pragma once
 
 #include "graph.hpp"
+#include "node_arena.hpp"
 
 /**
 @file async_task.hpp
@@ -135,7 +136,7 @@ inline void AsyncTask::_decref() {
   if(_node && std::get_if<Node::DependentAsync>(&(_node->_handle))->use_count.fetch_sub(
       1, std::memory_order_acq_rel
     ) == 1) {
-    recycle(_node);
+    recycle_async(_node);
   }
 }
 
@@ -98,8 +98,11 @@ inline void AtomicNotifier::notify_n(size_t n) noexcept {
   if(n >= _waiters.size()) {
     notify_all();
   }
-  else {
-    for(size_t k=0; k<n; ++k) {
+  else if(n != 0) {
+    // the first notify_one issues the fence that orders our queue updates
+    // before the waiter count we read; stop once nobody is left waiting
+    notify_one();
+    for(size_t k=1; k<n && num_waiters() != 0; ++k) {
       notify_one();
     }
   }
@@ -0,0 +1,703 @@
+#pragma once
+
+#include "observer.hpp"
+
+/**
+@file critical_path.hpp
+@brief critical-path analyzer include file
+
+This header is not included by taskflow.hpp; include it explicitly to
+analyze recorded executions.
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: CriticalPathAnalyzer
+// ----------------------------------------------------------------------------
+
+/**
+@class CriticalPathAnalyzer
+
+@brief class to analyze the critical path and the parallelism of recorded
+       taskflow executions
+
+A tf::CriticalPathAnalyzer joins the graph written by tf::Taskflow::dump with
+the segments a tf::TFProfObserver recorded while the taskflow ran (or that
+tf::TFStreamObserver::load decoded from a stream file) and computes:
+
+  + the @em work, i.e., the sum of the task durations, and the @em span,
+    i.e., the length of the longest dependency chain weighted by duration,
+    whose ratio is the ideal speedup on unlimited workers
+  + the critical path itself and, for every task, its @em slack, i.e., how
+    much longer it could run without making the span longer
+  + the parallelism of each run over time: on average, how many tasks were
+    running and how many were available (ready or running)
+  + the scheduling gaps: how long each task waited between becoming ready
+    and starting, and how long ready tasks waited while a worker was idle
+
+Tasks are matched to segments by name, so every task to analyze needs a
+unique name; unnamed tasks, modules and tasks with a duplicated name take
+no time in the analysis and are counted in the report.
+When the observer saw the taskflow run several times, the k-th segment of
+each task belongs to the k-th run, and the critical path uses the mean
+duration of each task.
+A subflow task is split into the task itself, which precedes its children,
+and a zero-time join that its children precede; the subflow graph is only
+in the dump if the subflow was retained (see tf::Subflow::retain).
+Condition edges are left out, so the analysis describes a single pass
+through a conditional graph.
+
+@code{.cpp}
+#include <taskflow/taskflow.hpp>
+#include <taskflow/core/critical_path.hpp>
+
+auto observer = executor.make_observer<tf::TFProfObserver>();
+executor.run(taskflow).wait();
+
+std::istringstream dot(taskflow.dump());
+tf::CriticalPathAnalyzer analyzer(dot, *observer);
+
+analyzer.report(std::cout);         // text report
+std::ofstream ofs("critical.dot");
+analyzer.dump(ofs);                 // DOT with the critical path highlighted
+@endcode
+*/
+class CriticalPathAnalyzer {
+
+  struct Vertex {
+    std::string id;
+    std::string name;
+    bool named {false};
+    bool join {false};
+    // per-run begin and end in nanoseconds from the origin of the timeline
+    std::vector<std::pair<int64_t, int64_t>> runs;
+    int64_t weight {0};
+    int64_t est {0};
+    int64_t slack {0};
+    size_t critical_pred {SIZE_MAX};
+    bool critical {false};
+    std::vector<size_t> succs;
+    std::vector<size_t> preds;
+  };
+
+  struct Edge {
+    size_t from;
+    size_t to;
+    // 0: dependency, 1: condition, 2: subflow spawn or join
+    int kind;
+    bool critical {false};
+  };
+
+  struct Wait {
+    size_t task;
+    size_t run;
+    int64_t wait;
+  };
+
+  public:
+
+    /**
+    @brief analyzes the graph in @c dot against the segments of @c profile
+
+    @param dot an input stream with the output of tf::Taskflow::dump
+    @param profile an observer holding the recorded segments
+
+    The constructor throws if the stream holds no task.
+    */
+    CriticalPathAnalyzer(std::istream& dot, const TFProfObserver& profile);
+
+    /**
+    @brief queries the sum of the durations of all tasks
+    */
+    std::chrono::nanoseconds work() const { return std::chrono::nanoseconds(_work); }
+
+    /**
+    @brief queries the length of the critical path
+    */
+    std::chrono::nanoseconds span() const { return std::chrono::nanoseconds(_span); }
+
+    /**
+    @brief queries the ideal speedup, i.e., work divided by span
+    */
+    double ideal_speedup() const { return _span ? double(_work) / _span : 0.0; }
+
+    /**
+    @brief queries the names of the tasks on the critical path, in order
+    */
+    std::vector<std::string> critical_path() const;
+
+    /**
+    @brief queries the slack of a task
+
+    Throws if no task has the given name.
+    */
+    std::chrono::nanoseconds slack(const std::string& name) const;
+
+    /**
+    @brief queries the average number of tasks running during a run
+    */
+    double achieved_parallelism() const { return _makespan ? _running / _makespan : 0.0; }
+
+    /**
+    @brief queries the average number of tasks ready or running during a run
+    */
+    double available_parallelism() const { return _makespan ? _available / _makespan : 0.0; }
+
+    /**
+    @brief queries the total time tasks waited between becoming ready and
+           starting, over all runs
+    */
+    std::chrono::nanoseconds ready_wait() const { return std::chrono::nanoseconds(_ready_wait); }
+
+    /**
+    @brief queries the total time in which a task was ready but not running
+           while fewer tasks than workers were running, over all runs
+    */
+    std::chrono::nanoseconds idle_ready_time() const {
+      return std::chrono::nanoseconds(_idle_ready);
+    }
+
+    /**
+    @brief writes the analysis report through an output stream
+
+    @param os output stream
+    @param top number of entries in each ranked list
+    */
+    void report(std::ostream& os, size_t top = 10) const;
+
+    /**
+    @brief returns the analysis report in a string
+    */
+    std::string report(size_t top = 10) const;
+
+    /**
+    @brief dumps the graph in DOT format, with every task labeled by its
+           mean duration and slack and the critical path highlighted
+    */
+    void dump(std::ostream& os) const;
+
+    /**
+    @brief dumps the annotated graph in DOT format to a string
+    */
+    std::string dump() const;
+
+  private:
+
+    std::vector<Vertex> _vertices;
+    std::vector<Edge> _edges;
+    std::vector<size_t> _order;
+    std::vector<Wait> _waits;
+
+    size_t _num_workers {0};
+    size_t _num_runs {0};
+    size_t _num_unmatched {0};
+    size_t _num_duplicated {0};
+
+    int64_t _work {0};
+    int64_t _span {0};
+    double _makespan {0};
+    double _running {0};
+    double _available {0};
+    int64_t _ready_wait {0};
+    int64_t _idle_ready {0};
+
+    void _parse(std::istream&);
+    void _match(const TFProfObserver&);
+    void _schedule();
+    void _replay();
+
+    static std::string _attribute(const std::string&, const std::string&);
+    static std::string _us(int64_t);
+};
+
+// Constructor
+inline CriticalPathAnalyzer::CriticalPathAnalyzer(
+  std::istream& dot, const TFProfObserver& profile
+) {
+  _parse(dot);
+  if(_vertices.empty()) {
+    TF_THROW("no task found in the graph dump");
+  }
+  _match(profile);
+  _schedule();
+  _replay();
+}
+
+// Function: _attribute
+inline std::string CriticalPathAnalyzer::_attribute(
+  const std::string& line, const std::string& key
+) {
+  auto p = line.find(key + "=\"");
+  if(p == std::string::npos) {
+    return "";
+  }
+  p += key.size() + 2;
+  return line.substr(p, line.find('"', p) - p);
+}
+
+// Procedure: _parse
+// reads the format written by Taskflow::dump: one node or edge per line,
+// with clusters for the taskflow, its modules and its subflows
+inline void CriticalPathAnalyzer::_parse(std::istream& is) {
+
+  std::unordered_map<std::string, size_t> ids;
+  std::vector<std::pair<std::string, std::string>> clusters;  // (cluster, parent node)
+  std::vector<std::tuple<std::string, std::string, int>> edges;
+  std::vector<std::pair<size_t, std::string>> members;        // (node, subflow parent)
+
+  auto vertex = [&](const std::string& id){
+    auto [itr, inserted] = ids.try_emplace(id, _vertices.size());
+    if(inserted) {
+      _vertices.emplace_back();
+      _vertices.back().id = id;
+    }
+    return itr->second;
+  };
+
+  std::string line;
+  while(std::getline(is, line)) {
+
+    if(line.rfind("subgraph cluster_", 0) == 0) {
+      auto c = line.substr(17, line.find(' ', 17) - 17);
+      clusters.emplace_back(c, ids.count(c) ? c : std::string());
+      continue;
+    }
+
+    if(line == "}") {
+      if(!clusters.empty()) {
+        clusters.pop_back();
+      }
+      continue;
+    }
+
+    if(line.empty() || line[0] != 'p') {
+      continue;
+    }
+
+    // edge
+    if(auto a = line.find("->"); a != std::string::npos) {
+      auto from = line.substr(0, line.find_first_of(" -", 0));
+      auto b = line.find('p', a + 2);
+      auto to = line.substr(b, line.find_first_of(" [;", b) - b);
+      int kind = line.find("color=blue") != std::string::npos ? 2 :
+                 line.find("style=dashed") != std::string::npos ? 1 : 0;
+      edges.emplace_back(from, to, kind);
+      continue;
+    }
+
+    // node
+    if(auto l = line.find('['); l != std::string::npos) {
+      auto v = vertex(line.substr(0, l));
+      auto label = _attribute(line, "label");
+      // a module label ends with the module id, e.g., "name [m1]"
+      if(line.find("shape=box3d") != std::string::npos) {
+        label = label.substr(0, label.rfind(" ["));
+      }
+      // an unnamed task is labeled with its id
+      _vertices[v].named = (label != _vertices[v].id);
+      _vertices[v].name = _vertices[v].named ? label : _vertices[v].id;
+      // a node declared in the cluster of a subflow is one of its children
+      if(!clusters.empty() && !clusters.back().second.empty()) {
+        members.emplace_back(v, clusters.back().second);
+      }
+    }
+  }
+
+  // split each subflow task with children into the task and a join that
+  // takes over its successors
+  std::unordered_map<size_t, size_t> joins;
+  for(auto& [v, parent] : members) {
+    auto p = ids.at(parent);
+    auto [itr, inserted] = joins.try_emplace(p, _vertices.size());
+    if(inserted) {
+      _vertices.emplace_back();
+      _vertices.back().id = _vertices[p].id + "_join";
+      _vertices.back().name = _vertices[p].name + " (join)";
+      _vertices.back().join = true;
+    }
+    _edges.push_back({p, v, 2});
+  }
+
+  for(auto& [from, to, kind] : edges) {
+    auto f = vertex(from);
+    auto t = vertex(to);
+    if(kind == 2) {
+      // the join edge of a child to its subflow
+      _edges.push_back({f, joins.count(t) ? joins[t] : t, 2});
+    }
+    else {
+      _edges.push_back({joins.count(f) ? joins[f] : f, t, kind});
+    }
+  }
+}
+
+// Procedure: _match
+inline void CriticalPathAnalyzer::_match(const TFProfObserver& profile) {
+
+  using namespace std::chrono;
+
+  const auto& tl = profile._timeline;
+  _num_workers = tl.segments.size();
+
+  std::unordered_map<std::string, size_t> names;
+  for(size_t v=0; v<_vertices.size(); ++v) {
+    auto& x = _vertices[v];
+    if(x.join) {
+      continue;
+    }
+    if(!x.named) {
+      ++_num_unmatched;
+      continue;
+    }
+    if(auto [itr, inserted] = names.try_emplace(x.name, v); !inserted) {
+      if(itr->second != SIZE_MAX) {
+        _num_duplicated += 2;
+        itr->second = SIZE_MAX;
+      }
+      else {
+        ++_num_duplicated;
+      }
+    }
+  }
+
+  for(const auto& levels : tl.segments) {
+    for(const auto& segments : levels) {
+      for(const auto& s : segments) {
+        if(auto itr = names.find(s.name); itr != names.end() && itr->second != SIZE_MAX) {
+          _vertices[itr->second].runs.emplace_back(
+            duration_cast<nanoseconds>(s.beg - tl.origin).count(),
+            duration_cast<nanoseconds>(s.end - tl.origin).count()
+          );
+        }
+      }
+    }
+  }
+
+  _num_runs = SIZE_MAX;
+  for(auto& x : _vertices) {
+    if(x.runs.empty()) {
+      if(x.named && !x.join && names[x.name] != SIZE_MAX) {
+        ++_num_unmatched;
+      }
+      continue;
+    }
+    std::sort(x.runs.begin(), x.runs.end());
+    int64_t sum = 0;
+    for(auto& [b, e] : x.runs) {
+      sum += e - b;
+    }
+    x.weight = sum / static_cast<int64_t>(x.runs.size());
+    _num_runs = (std::min)(_num_runs, x.runs.size());
+  }
+  if(_num_runs == SIZE_MAX) {
+    _num_runs = 0;
+  }
+}
+
+// Procedure: _schedule
+// computes the earliest start of every task on unlimited workers, the
+// span, the critical path and the slack of every task; condition edges
+// are left out
+inline void CriticalPathAnalyzer::_schedule() {
+
+  for(size_t e=0; e<_edges.size(); ++e) {
+    if(_edges[e].kind != 1) {
+      _vertices[_edges[e].from].succs.push_back(e);
+      _vertices[_edges[e].to].preds.push_back(e);
+    }
+  }
+
+  // topological order (Kahn); tasks on a cycle are left out
+  std::vector<size_t> indegree(_vertices.size());
+  for(size_t v=0; v<_vertices.size(); ++v) {
+    indegree[v] = _vertices[v].preds.size();
+    if(indegree[v] == 0) {
+      _order.push_back(v);
+    }
+  }
+  for(size_t i=0; i<_order.size(); ++i) {
+    for(auto e : _vertices[_order[i]].succs) {
+      if(--indegree[_edges[e].to] == 0) {
+        _order.push_back(_edges[e].to);
+      }
+    }
+  }
+
+  // forward pass
+  size_t last = SIZE_MAX;
+  for(auto v : _order) {
+    auto& x = _vertices[v];
+    for(auto e : x.preds) {
+      auto& p = _vertices[_edges[e].from];
+      if(x.critical_pred == SIZE_MAX || p.est + p.weight > x.est) {
+        x.est = p.est + p.weight;
+        x.critical_pred = e;
+      }
+    }
+    _work += x.weight;
+    if(last == SIZE_MAX || x.est + x.weight > _span) {
+      _span = x.est + x.weight;
+      last = v;
+    }
+  }
+
+  // backward pass: the latest finish that keeps the span
+  std::vector<int64_t> lft(_vertices.size(), _span);
+  for(size_t i=_order.size(); i-- > 0;) {
+    auto v = _order[i];
+    auto& x = _vertices[v];
+    for(auto e : x.succs) {
+      auto& s = _vertices[_edges[e].to];
+      lft[v] = (std::min)(lft[v], s.est + s.slack);
+    }
+    x.slack = lft[v] - x.weight - x.est;
+  }
+
+  // walk back from the task that finishes last
+  for(auto v = last; v != SIZE_MAX;) {
+    auto& x = _vertices[v];
+    x.critical = true;
+    if(x.critical_pred == SIZE_MAX) {
+      break;
+    }
+    _edges[x.critical_pred].critical = true;
+    v = _edges[x.critical_pred].from;
+  }
+}
+
+// Procedure: _replay
+// measures, run by run, when each task became ready and how many tasks
+// were running or available over time
+inline void CriticalPathAnalyzer::_replay() {
+
+  std::vector<int64_t> ready(_vertices.size()), finish(_vertices.size());
+
+  for(size_t r=0; r<_num_runs; ++r) {
+
+    int64_t origin = INT64_MAX, end = INT64_MIN;
+    for(auto& x : _vertices) {
+      if(!x.runs.empty()) {
+        origin = (std::min)(origin, x.runs[r].first);
+        end = (std::max)(end, x.runs[r].second);
+      }
+    }
+
+    // +1/-1 events on (time, available, running)
+    std::vector<std::tuple<int64_t, int, int>> events;
+
+    for(auto v : _order) {
+      auto& x = _vertices[v];
+      ready[v] = origin;
+      for(auto e : x.preds) {
+        ready[v] = (std::max)(ready[v], finish[_edges[e].from]);
+      }
+      if(x.runs.empty()) {
+        finish[v] = ready[v];
+        continue;
+      }
+      auto [b, f] = x.runs[r];
+      finish[v] = f;
+      // a task that started before its predecessors finished (e.g., a
+      // name shared with an untimed task) is not counted as waiting
+      auto rdy = (std::min)(ready[v], b);
+      _ready_wait += b - rdy;
+      _waits.push_back({v, r, b - rdy});
+      events.emplace_back(rdy, +1, 0);
+      events.emplace_back(b, 0, +1);
+      events.emplace_back(f, -1, -1);
+    }
+
+    std::sort(events.begin(), events.end());
+
+    int64_t available = 0, running = 0, prev = origin;
+    for(auto& [t, a, n] : events) {
+      auto dt = t - prev;
+      _available += double(available) * dt;
+      _running += double(running) * dt;
+      if(available > running && running < static_cast<int64_t>(_num_workers)) {
+        _idle_ready += dt;
+      }
+      available += a;
+      running += n;
+      prev = t;
+    }
+    _makespan += double(end - origin);
+  }
+
+  std::sort(_waits.begin(), _waits.end(), [](const Wait& a, const Wait& b){
+    return a.wait > b.wait;
+  });
+}
+
+// Function: critical_path
+inline std::vector<std::string> CriticalPathAnalyzer::critical_path() const {
+  std::vector<std::string> path;
+  for(auto v : _order) {
+    if(_vertices[v].critical && !_vertices[v].join) {
+      path.push_back(_vertices[v].name);
+    }
+  }
+  return path;
+}
+
+// Function: slack
+inline std::chrono::nanoseconds CriticalPathAnalyzer::slack(const std::string& name) const {
+  for(auto& x : _vertices) {
+    if(x.named && x.name == name) {
+      return std::chrono::nanoseconds(x.slack);
+    }
+  }
+  TF_THROW("no task named ", name);
+}
+
+// Function: _us
+inline std::string CriticalPathAnalyzer::_us(int64_t ns) {
+  std::ostringstream oss;
+  oss << std::fixed << std::setprecision(1) << ns / 1e3;
+  return oss.str();
+}
+
+// Procedure: report
+inline void CriticalPathAnalyzer::report(std::ostream& os, size_t top) const {
+
+  size_t num_tasks = 0, num_timed = 0;
+  for(auto& x : _vertices) {
+    num_tasks += !x.join;
+    num_timed += !x.runs.empty();
+  }
+
+  double makespan = _num_runs ? _makespan / _num_runs : 0.0;
+
+  os << "==Critical path analysis: " << num_tasks << " tasks ("
+     << num_timed << " timed, " << _num_unmatched << " unmatched, "
+     << _num_duplicated << " with duplicated names), "
+     << _num_runs << " runs on " << _num_workers << " workers\n";
+
+  os << std::setw(28) << std::left << "work (us)" << _us(_work) << '\n'
+     << std::setw(28) << "span (us)" << _us(_span) << '\n'
+     << std::setw(28) << "ideal speedup" << std::fixed << std::setprecision(2)
+     << ideal_speedup() << '\n'
+     << std::setw(28) << "makespan per run (us)" << _us(static_cast<int64_t>(makespan)) << '\n'
+     << std::setw(28) << "achieved parallelism" << achieved_parallelism() << '\n'
+     << std::setw(28) << "available parallelism" << available_parallelism() << '\n'
+     << std::setw(28) << "ready wait (us)" << _us(_ready_wait) << '\n'
+     << std::setw(28) << "idle while ready (us)" << _us(_idle_ready) << '\n'
+     << std::right;
+
+  // tasks on the critical path, longest first: the candidates to speed up
+  // or split
+  std::vector<size_t> path;
+  for(auto v : _order) {
+    if(_vertices[v].critical && !_vertices[v].join) {
+      path.push_back(v);
+    }
+  }
+
+  os << "\nCritical path: " << path.size() << " tasks\n";
+  for(size_t i=0; i<path.size(); ++i) {
+    os << (i ? " -> " : "  ") << _vertices[path[i]].name;
+  }
+  os << '\n';
+
+  std::stable_sort(path.begin(), path.end(), [this](size_t a, size_t b){
+    return _vertices[a].weight > _vertices[b].weight;
+  });
+
+  os << '\n' << std::setw(24) << "-Critical Task-" << std::setw(12) << "Time (us)"
+     << std::setw(12) << "Start (us)" << std::setw(10) << "Span %" << '\n';
+  for(size_t i=0; i<path.size() && i<top; ++i) {
+    auto& x = _vertices[path[i]];
+    os << std::setw(24) << x.name << std::setw(12) << _us(x.weight)
+       << std::setw(12) << _us(x.est) << std::setw(10) << std::setprecision(1)
+       << (_span ? 100.0 * x.weight / _span : 0.0) << '\n';
+  }
+
+  // the non-critical tasks closest to becoming critical
+  std::vector<size_t> tight;
+  for(size_t v=0; v<_vertices.size(); ++v) {
+    if(!_vertices[v].critical && !_vertices[v].join && !_vertices[v].runs.empty()) {
+      tight.push_back(v);
+    }
+  }
+  std::stable_sort(tight.begin(), tight.end(), [this](size_t a, size_t b){
+    return _vertices[a].slack < _vertices[b].slack;
+  });
+
+  os << '\n' << std::setw(24) << "-Least Slack-" << std::setw(12) << "Time (us)"
+     << std::setw(12) << "Slack (us)" << '\n';
+  for(size_t i=0; i<tight.size() && i<top; ++i) {
+    auto& x = _vertices[tight[i]];
+    os << std::setw(24) << x.name << std::setw(12) << _us(x.weight)
+       << std::setw(12) << _us(x.slack) << '\n';
+  }
+
+  os << '\n' << std::setw(24) << "-Longest Ready Wait-" << std::setw(12) << "Wait (us)"
+     << std::setw(12) << "Run" << '\n';
+  for(size_t i=0; i<_waits.size() && i<top; ++i) {
+    os << std::setw(24) << _vertices[_waits[i].task].name
+       << std::setw(12) << _us(_waits[i].wait) << std::setw(12) << _waits[i].run << '\n';
+  }
+}
+
+// Function: report
+inline std::string CriticalPathAnalyzer::report(size_t top) const {
+  std::ostringstream oss;
+  report(oss, top);
+  return oss.str();
+}
+
+// Procedure: dump
+inline void CriticalPathAnalyzer::dump(std::ostream& os) const {
+
+  os << "digraph CriticalPath {\n"
+     << "label=\"span " << _us(_span) << " us, work " << _us(_work)
+     << " us, ideal speedup " << std::fixed << std::setprecision(2) << ideal_speedup()
+     << "\";\n";
+
+  for(auto& x : _vertices) {
+    os << x.id;
+    if(x.join) {
+      os << "[shape=point";
+    }
+    else {
+      os << "[label=\"" << x.name << "\\n" << _us(x.weight) << " us";
+      if(!x.runs.empty()) {
+        os << ", slack " << _us(x.slack) << " us";
+      }
+      os << '"';
+    }
+    if(x.critical) {
+      os << " color=red style=filled fillcolor=mistyrose penwidth=2";
+    }
+    else if(x.runs.empty() && !x.join) {
+      os << " style=dotted";
+    }
+    os << "];\n";
+  }
+
+  for(auto& e : _edges) {
+    os << _vertices[e.from].id << " -> " << _vertices[e.to].id;
+    if(e.critical) {
+      os << " [color=red penwidth=2]";
+    }
+    else if(e.kind == 1) {
+      os << " [style=dashed]";
+    }
+    else if(e.kind == 2) {
+      os << " [color=blue]";
+    }
+    os << ";\n";
+  }
+
+  os << "}\n";
+}
+
+// Function: dump
+inline std::string CriticalPathAnalyzer::dump() const {
+  std::ostringstream oss;
+  dump(oss);
+  return oss.str();
+}
+
+}  // end of namespace tf -----------------------------------------------------
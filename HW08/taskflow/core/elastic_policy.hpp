@@ -0,0 +1,137 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+/**
+@file elastic_policy.hpp
+@brief elastic policy include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: ElasticPolicy
+// ----------------------------------------------------------------------------
+
+/**
+@struct ElasticPolicy
+
+@brief class to configure an executor that grows and shrinks the number of
+       its active workers at runtime
+
+An elastic executor creates @c max_workers threads but keeps only the
+workers with ids below its active count in the scheduling loop; the others
+are @em parked on a condition variable, where they use no CPU, are never
+woken up for new tasks and are skipped as steal victims.
+A controller thread samples two signals every @c interval:
+
+  + the queue depth, i.e., the number of tasks waiting in the worker queues
+    and the executor's shared buffers
+  + the idle fraction, i.e., the share of the interval the active workers
+    spent yielding or sleeping (see tf::IdleStats)
+
+When the queue depth exceeds @c grow_depth tasks per active worker, one
+parked worker is woken up.
+When the idle fraction stays above @c shrink_idle for @c shrink_after
+consecutive intervals, the worker with the highest active id parks as soon
+as it runs out of tasks.
+The active count never leaves <tt>[min_workers, max_workers]</tt>.
+
+@code{.cpp}
+tf::ElasticPolicy policy;
+policy.min_workers = 2;
+policy.max_workers = 16;
+tf::Executor executor(policy);   // starts with 2 active workers
+@endcode
+*/
+struct ElasticPolicy {
+
+  /**
+  @brief minimum number of active workers (must be at least one)
+  */
+  size_t min_workers {1};
+
+  /**
+  @brief number of worker threads, which bounds the active count
+         (@c 0 uses std::thread::hardware_concurrency)
+  */
+  size_t max_workers {0};
+
+  /**
+  @brief sampling period of the controller
+  */
+  std::chrono::microseconds interval {1000};
+
+  /**
+  @brief queued tasks per active worker above which a worker is added
+  */
+  size_t grow_depth {4};
+
+  /**
+  @brief idle fraction of the active workers above which an interval counts
+         toward parking a worker
+  */
+  double shrink_idle {0.5};
+
+  /**
+  @brief consecutive idle intervals before a worker is parked
+  */
+  size_t shrink_after {10};
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: ElasticStats
+// ----------------------------------------------------------------------------
+
+/**
+@struct ElasticStats
+
+@brief class to report the resizing activity of an elastic executor
+
+Grows and shrinks count the controller's decisions.
+The latency of a grow runs from the decision to the woken worker
+re-entering the scheduling loop, and is zero for a worker that had not
+parked yet; the latency of a shrink runs from the decision to the worker
+being parked, which includes the time it takes the worker to finish its
+queued tasks.
+*/
+struct ElasticStats {
+
+  /**
+  @brief number of workers currently allowed to run
+  */
+  size_t num_active_workers {0};
+
+  /**
+  @brief number of times a parked worker was woken up
+  */
+  size_t num_grows {0};
+
+  /**
+  @brief number of times a worker was parked
+  */
+  size_t num_shrinks {0};
+
+  /**
+  @brief total latency of all grows
+  */
+  std::chrono::nanoseconds grow_latency {0};
+
+  /**
+  @brief largest latency of a single grow
+  */
+  std::chrono::nanoseconds max_grow_latency {0};
+
+  /**
+  @brief total latency of all shrinks
+  */
+  std::chrono::nanoseconds shrink_latency {0};
+
+  /**
+  @brief largest latency of a single shrink
+  */
+  std::chrono::nanoseconds max_shrink_latency {0};
+};
+
+}  // end of namespace tf -----------------------------------------------------
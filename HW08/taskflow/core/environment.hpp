@@ -1,6 +1,8 @@
 #pragma once
 
 #define TF_ENABLE_PROFILER "TF_ENABLE_PROFILER"
+#define TF_ENABLE_STREAM_PROFILER "TF_ENABLE_STREAM_PROFILER"
+#define TF_PROFILER_SAMPLING "TF_PROFILER_SAMPLING"
 
 namespace tf {
 
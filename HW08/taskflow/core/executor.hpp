@@ -4,6 +4,8 @@
 #include "taskflow.hpp"
 #include "async_task.hpp"
 #include "freelist.hpp"
+#include "elastic_policy.hpp"
+#include "../utility/numa.hpp"
 
 /**
 @file executor.hpp
@@ -79,6 +81,64 @@ class Executor {
     std::shared_ptr<WorkerInterface> wix = nullptr
   );
 
+  /**
+  @brief constructs the executor with @c N worker threads placed on NUMA nodes
+
+  @param N number of workers
+  @param numa NUMA topology to place workers on (see tf::NumaTopology::discover)
+  @param wix interface class instance to configure workers' behaviors
+
+  Workers are distributed over the nodes of @c numa in proportion to their
+  CPU counts, and each worker is bound to the CPUs of its cluster
+  (the CPUs sharing its last-level cache) before
+  tf::WorkerInterface::scheduler_prologue is invoked.
+  Stealing is hierarchical: a worker first picks victims in its cluster,
+  widens to the queues of its node after repeated failed attempts, and only
+  then steals from remote nodes.
+  Tasks submitted from threads outside the executor go to the buffer of the
+  node the submitting thread is running on.
+
+  @code{.cpp}
+  tf::NumaTopology numa = tf::NumaTopology::discover();
+  tf::Executor executor(numa.num_cpus(), numa);
+  @endcode
+  */
+  Executor(
+    size_t N,
+    const NumaTopology& numa,
+    std::shared_ptr<WorkerInterface> wix = nullptr
+  );
+
+  /**
+  @brief constructs an elastic executor whose number of active workers
+         follows the load
+
+  @param policy bounds and scaling thresholds (see tf::ElasticPolicy)
+  @param wix interface class instance to configure workers' behaviors
+
+  The constructor spawns <tt>policy.max_workers</tt> worker threads, of
+  which only <tt>policy.min_workers</tt> stay active; the others park as
+  soon as they are idle.
+  A controller thread then wakes up parked workers when tasks queue up and
+  parks workers again when the active ones are mostly idle.
+  Parked workers are neither woken up for new tasks nor stolen from.
+  An exception is thrown if @c min_workers is zero or exceeds
+  @c max_workers.
+
+  @code{.cpp}
+  tf::ElasticPolicy policy;
+  policy.min_workers = 2;
+  policy.max_workers = 16;
+  tf::Executor executor(policy);
+  executor.num_workers();         // 16
+  executor.num_active_workers();  // 2, grows under load
+  @endcode
+  */
+  explicit Executor(
+    const ElasticPolicy& policy,
+    std::shared_ptr<WorkerInterface> wix = nullptr
+  );
+
   /**
   @brief destructs the executor
 
@@ -570,6 +630,85 @@ class Executor {
   @endcode
   */
   int this_worker_id() const;
+
+  /**
+  @brief sets how idle workers back off before they sleep
+
+  @param policy idle policy (see tf::IdlePolicy)
+
+  Each worker picks up the new policy the next time it runs out of tasks.
+  The default policy is tf::IdlePolicy::balanced.
+  An exception is thrown if the policy asks for more minimum yields than
+  maximum yields.
+
+  @code{.cpp}
+  tf::Executor executor;
+  executor.set_idle_policy(tf::IdlePolicy::latency());
+  @endcode
+  */
+  void set_idle_policy(const IdlePolicy& policy);
+
+  /**
+  @brief queries the idle policy of the executor
+  */
+  IdlePolicy idle_policy() const;
+
+  /**
+  @brief queries the time all workers have spent idle in each phase of the
+         idle policy
+
+  Per-worker numbers are available from tf::Worker::idle_stats
+  and tf::WorkerView::idle_stats.
+  A sleep is counted once the worker wakes up from it.
+
+  @code{.cpp}
+  executor.run(taskflow).wait();
+  auto stats = executor.idle_stats();
+  std::cout << stats.spin.count() << ' ' << stats.yield.count() << ' '
+            << stats.sleep.count() << '\n';
+  @endcode
+  */
+  IdleStats idle_stats() const;
+
+  /**
+  @brief takes a snapshot of the scheduling metrics of all workers
+
+  The executor counts, per worker, the task callables it ran, successful
+  and failed steals, tasks spilled to the shared buffers, sleeps and
+  wake-ups, and keeps a histogram of task durations per task type.
+  Counting costs a few relaxed stores to worker-local cache lines per task,
+  plus two tf::read_tsc calls on one in TF_METRICS_TIMING_INTERVAL tasks,
+  so it is always on unless TF_DISABLE_METRICS is defined.
+  With TF_DISABLE_METRICS, only the sleeps and the explore and sleep times
+  are kept, as they come from the idle statistics (see Executor::idle_stats).
+
+  @code{.cpp}
+  executor.run(taskflow).wait();
+  executor.metrics().dump_prometheus(std::cout);
+  @endcode
+  */
+  ExecutorMetrics metrics() const;
+
+  /**
+  @brief queries the number of workers allowed to run tasks
+
+  This equals Executor::num_workers except for an elastic executor,
+  where the remaining workers are parked.
+  */
+  size_t num_active_workers() const noexcept;
+
+  /**
+  @brief queries the resizing activity of an elastic executor
+
+  All counters are zero for an executor that is not elastic.
+
+  @code{.cpp}
+  auto stats = executor.elastic_stats();
+  std::cout << stats.num_active_workers << ' ' << stats.num_grows << ' '
+            << stats.max_grow_latency.count() << '\n';
+  @endcode
+  */
+  ElasticStats elastic_stats() const;
  
   // --------------------------------------------------------------------------
   // Observer methods
@@ -1068,15 +1207,69 @@ class Executor {
   
   std::list<Taskflow> _taskflows;
 
-  Freelist<Node*> _buffers;
+  Freelist<Node*, static_cast<size_t>(TaskPriority::MAX)> _buffers;
+
+  // number of high-priority nodes sitting in _buffers, which busy workers
+  // check before running a local task of lower priority
+  alignas(TF_CACHELINE_SIZE) std::atomic<size_t> _num_buffered_high {0};
+
+#ifndef TF_DISABLE_NODE_ARENA
+  // nodes of async tasks; released only after the workers have joined
+  std::unique_ptr<NodeArena, NodeArena::Releaser> _node_arena;
+#endif
 
   std::shared_ptr<WorkerInterface> _worker_interface;
+
+  // idle policy, copied by each worker whenever _idle_epoch moves
+  mutable std::mutex _idle_mutex;
+  IdlePolicy _idle_policy;
+  std::atomic<size_t> _idle_epoch {0};
+
+  // clock readings at construction, to convert task durations from ticks,
+  // and the conversion once it is fixed
+  const uint64_t _origin_tsc {read_tsc()};
+  const observer_stamp_t _origin_time {observer_stamp_t::clock::now()};
+  mutable std::atomic<double> _ns_per_tick {0.0};
+
+  // elastic mode (see tf::ElasticPolicy): only workers [0, _num_active) run
+  // and the others wait on _park_cv; _elastic_thread samples the load and
+  // moves _num_active under _park_mutex, recording in _resize_time when it
+  // asked each worker to park or to resume
+  std::atomic<size_t> _num_active {0};
+  ElasticPolicy _elastic_policy;
+  mutable std::mutex _park_mutex;
+  std::condition_variable _park_cv;
+  std::condition_variable _elastic_cv;
+  bool _elastic_stop {false};
+  std::thread _elastic_thread;
+  ElasticStats _elastic_stats;
+  std::vector<bool> _parked;
+  std::vector<std::chrono::steady_clock::time_point> _resize_time;
+
+  // NUMA placement (empty for an executor without a topology): domain of
+  // each CPU id, and the CPUs each worker is bound to
+  std::vector<size_t> _cpu_domains;
+  std::vector<std::vector<int>> _worker_cpus;
   std::unordered_set<std::shared_ptr<ObserverInterface>> _observers;
 
-  void _observer_prologue(Worker&, Node*);
-  void _observer_epilogue(Worker&, Node*);
+  uint64_t _observer_prologue(Worker&, Node*);
+  void _observer_epilogue(Worker&, Node*, uint64_t);
   void _spawn(size_t);
+  void _set_up_victims(const std::vector<size_t>&);
+  static std::vector<size_t> _numa_workers(size_t, const NumaTopology&);
+  size_t _next_victim(Worker&, size_t);
+  Node* _steal(Worker&, size_t);
+  Node* _steal_buffered_high(Worker&);
+  void _push_to_buffers(Node*, size_t);
+  size_t _this_domain() const;
+  const IdlePolicy& _refresh_idle_policy(Worker&);
+  size_t _yield_budget(Worker&) const;
+  static size_t _elastic_num_workers(const ElasticPolicy&);
+  bool _park(Worker&);
+  void _elastic_loop();
+  void _set_num_active(size_t);
   void _exploit_task(Worker&, Node*&);
+  void _serve_buffers(Worker&, Node*&);
   bool _explore_task(Worker&, Node*&);
   void _schedule(Worker&, Node*);
   void _schedule(Node*);
@@ -1094,6 +1287,9 @@ class Executor {
   void _process_async_dependent(Node*, tf::AsyncTask&, size_t&);
   void _process_exception(Worker&, Node*);
   void _schedule_async_task(Node*);
+
+  template <typename... ArgsT>
+  Node* _animate_async(ArgsT&&...);
   void _update_cache(Worker&, Node*&, Node*);
 
   bool _wait_for_task(Worker&, Node*&);
@@ -1103,8 +1299,8 @@ class Executor {
   bool _invoke_async_task(Worker&, Node*);
   bool _invoke_dependent_async_task(Worker&, Node*);
   bool _invoke_runtime_task(Worker&, Node*);
-  bool _invoke_runtime_task_impl(Worker&, Node*, std::function<void(Runtime&)>&);
-  bool _invoke_runtime_task_impl(Worker&, Node*, std::function<void(Runtime&, bool)>&);
+  bool _invoke_runtime_task_impl(Worker&, Node*, SmallFunction<void(Runtime&)>&);
+  bool _invoke_runtime_task_impl(Worker&, Node*, SmallFunction<void(Runtime&, bool)>&);
 
   template <typename I>
   I _set_up_graph(I, I, Topology*, Node*);
@@ -1139,12 +1335,90 @@ inline Executor::Executor(size_t N, std::shared_ptr<WorkerInterface> wix) :
   _workers  (N),
   _notifier (N),
   _buffers  (N),
+#ifndef TF_DISABLE_NODE_ARENA
+  _node_arena {new NodeArena(this, N)},
+#endif
   _worker_interface(std::move(wix)) {
 
   if(N == 0) {
     TF_THROW("executor must define at least one worker");
   }
 
+  // flat layout: every worker steals uniformly from every queue
+  for(auto& w : _workers) {
+    w._victims.resize(num_queues());
+    std::iota(w._victims.begin(), w._victims.end(), 0);
+    w._victim_tiers[0] = w._victim_tiers[1] = num_queues();
+  }
+
+  // a stream observer opens its file here, before any worker runs
+  if(has_env(TF_ENABLE_STREAM_PROFILER)) {
+    make_observer<TFStreamObserver>(
+      TFStreamObserver::_env_path(), TFStreamObserver::_env_sampling()
+    );
+  }
+
+  _spawn(N);
+
+  // initialize the default observer if requested
+  if(has_env(TF_ENABLE_PROFILER)) {
+    TFProfManager::get()._manage(make_observer<TFProfObserver>());
+  }
+}
+
+// Constructor
+inline Executor::Executor(
+  size_t N, const NumaTopology& numa, std::shared_ptr<WorkerInterface> wix
+) :
+  _workers  (N),
+  _notifier (N),
+  _buffers  (_numa_workers(N, numa)),
+#ifndef TF_DISABLE_NODE_ARENA
+  _node_arena {new NodeArena(this, N)},
+#endif
+  _worker_interface(std::move(wix)) {
+
+  if(N == 0) {
+    TF_THROW("executor must define at least one worker");
+  }
+
+  auto& nodes = numa.nodes();
+  auto counts = _numa_workers(N, numa);
+
+  // workers of a domain get consecutive ids and fill its clusters in order
+  std::vector<size_t> clusters(N);
+  _worker_cpus.resize(N);
+
+  for(size_t d=0, id=0; d<nodes.size(); ++d) {
+    auto& node = nodes[d];
+    for(auto c : node.cpus) {
+      if(static_cast<size_t>(c) >= _cpu_domains.size()) {
+        _cpu_domains.resize(c + 1, 0);
+      }
+      _cpu_domains[c] = d;
+    }
+    for(size_t j=0; j<counts[d]; ++j, ++id) {
+      auto cluster = node.clusters[j % node.cpus.size()];
+      _workers[id]._domain = d;
+      _workers[id]._numa_node = node.id;
+      clusters[id] = cluster;
+      for(size_t k=0; k<node.cpus.size(); ++k) {
+        if(node.clusters[k] == cluster) {
+          _worker_cpus[id].push_back(node.cpus[k]);
+        }
+      }
+    }
+  }
+
+  _set_up_victims(clusters);
+
+  // a stream observer opens its file here, before any worker runs
+  if(has_env(TF_ENABLE_STREAM_PROFILER)) {
+    make_observer<TFStreamObserver>(
+      TFStreamObserver::_env_path(), TFStreamObserver::_env_sampling()
+    );
+  }
+
   _spawn(N);
 
   // initialize the default observer if requested
@@ -1153,12 +1427,174 @@ inline Executor::Executor(size_t N, std::shared_ptr<WorkerInterface> wix) :
   }
 }
 
+// Constructor
+inline Executor::Executor(const ElasticPolicy& policy, std::shared_ptr<WorkerInterface> wix) :
+  Executor(_elastic_num_workers(policy), std::move(wix)) {
+
+  _elastic_policy = policy;
+  _parked.resize(_workers.size(), false);
+  _resize_time.resize(_workers.size());
+
+  // workers beyond min_workers park once idle; that is not counted as a shrink
+  {
+    std::scoped_lock lock(_park_mutex);
+    _num_active.store(policy.min_workers, std::memory_order_release);
+  }
+
+  _elastic_thread = std::thread([this](){ _elastic_loop(); });
+}
+
+// Function: _numa_workers
+// Workers per node, proportional to the CPUs of each node; the remainder
+// goes round-robin from the first node.
+inline std::vector<size_t> Executor::_numa_workers(size_t N, const NumaTopology& numa) {
+  auto& nodes = numa.nodes();
+  std::vector<size_t> counts(nodes.size());
+  size_t assigned = 0;
+  for(size_t d=0; d<nodes.size(); ++d) {
+    counts[d] = N * nodes[d].cpus.size() / numa.num_cpus();
+    assigned += counts[d];
+  }
+  for(size_t d=0; assigned<N; d=(d+1)%nodes.size(), ++assigned) {
+    ++counts[d];
+  }
+  return counts;
+}
+
+// Procedure: _set_up_victims
+// Orders each worker's victims by locality: workers of its cluster, then the
+// rest of its domain together with the domain's buffers, then everything else.
+inline void Executor::_set_up_victims(const std::vector<size_t>& clusters) {
+
+  const size_t W = _workers.size();
+
+  // workers are indexed by position: this runs before _spawn assigns _id
+  for(size_t id=0; id<W; ++id) {
+
+    auto& w = _workers[id];
+    auto& v = w._victims;
+    v.clear();
+    v.reserve(num_queues());
+
+    auto local = [&](size_t i) { return _workers[i]._domain == w._domain; };
+
+    for(size_t i=0; i<W; ++i) {
+      if(i != id && local(i) && clusters[i] == clusters[id]) {
+        v.push_back(i);
+      }
+    }
+    w._victim_tiers[0] = v.size();
+
+    for(size_t i=0; i<W; ++i) {
+      if(local(i) && clusters[i] != clusters[id]) {
+        v.push_back(i);
+      }
+    }
+    for(size_t b=_buffers.domain_begin(w._domain); b<_buffers.domain_end(w._domain); ++b) {
+      v.push_back(W + b);
+    }
+    w._victim_tiers[1] = v.size();
+
+    for(size_t i=0; i<W; ++i) {
+      if(!local(i)) {
+        v.push_back(i);
+      }
+    }
+    for(size_t b=0; b<_buffers.size(); ++b) {
+      if(b < _buffers.domain_begin(w._domain) || b >= _buffers.domain_end(w._domain)) {
+        v.push_back(W + b);
+      }
+    }
+  }
+}
+
+// Function: _next_victim
+// Picks a random victim from the nearest tier that has not yet seen twice
+// as many failed steals as it has queues; a flat executor has a single
+// tier, which makes this a uniform pick over all queues.
+TF_FORCE_INLINE size_t Executor::_next_victim(Worker& w, size_t num_steals) {
+  // an elastic executor is flat and skips the queues of parked workers
+  if(size_t a = _num_active.load(std::memory_order_relaxed); a < _workers.size()) {
+    auto r = std::uniform_int_distribution<size_t>(0, a + _buffers.size() - 1)(w._rdgen);
+    return r < a ? r : _workers.size() + (r - a);
+  }
+  auto& t = w._victim_tiers;
+  size_t n = (num_steals < 2*t[0]) ? t[0] :
+             (num_steals < 2*t[1]) ? t[1] : w._victims.size();
+  return w._victims[std::uniform_int_distribution<size_t>(0, n-1)(w._rdgen)];
+}
+
+// Function: _steal
+// Steals from a worker queue or a buffer; one in every TF_TASK_PRIORITY_AGING
+// attempts of a worker serves the lowest-priority lane first so that low
+// priority tasks keep moving while the higher lanes stay busy.
+TF_FORCE_INLINE Node* Executor::_steal(Worker& w, size_t vtm) {
+  bool aged = (++w._num_steal_attempts % TF_TASK_PRIORITY_AGING == 0);
+  if(vtm < _workers.size()) {
+    return _workers[vtm]._wsq.steal(aged);
+  }
+  auto t = _buffers.steal(vtm - _workers.size(), aged);
+  if(t && t->_priority == TaskPriority::HIGH) {
+    _num_buffered_high.fetch_sub(1, std::memory_order_relaxed);
+  }
+  return t;
+}
+
+// Function: _steal_buffered_high
+// Takes a high-priority node from the buffers, starting with the buckets of
+// this worker's domain.
+inline Node* Executor::_steal_buffered_high(Worker& w) {
+  const size_t B = _buffers.size();
+  const size_t beg = _buffers.domain_begin(w._domain);
+  for(size_t i=0; i<B; ++i) {
+    if(auto t = _buffers.steal_lane((beg + i) % B, static_cast<size_t>(TaskPriority::HIGH)); t) {
+      _num_buffered_high.fetch_sub(1, std::memory_order_relaxed);
+      return t;
+    }
+  }
+  return nullptr;
+}
+
+// Procedure: _push_to_buffers
+// The counter is raised before the push so it never drops below the number
+// of high-priority nodes a thief can find.
+TF_FORCE_INLINE void Executor::_push_to_buffers(Node* node, size_t d) {
+  if(node->_priority == TaskPriority::HIGH) {
+    _num_buffered_high.fetch_add(1, std::memory_order_relaxed);
+  }
+  _buffers.push(node, d, static_cast<size_t>(node->_priority));
+}
+
+// Function: _this_domain
+// Domain for a push from the calling thread: a worker's own domain or the
+// domain of the CPU an external thread is currently running on.
+inline size_t Executor::_this_domain() const {
+  if(_cpu_domains.empty()) {
+    return 0;
+  }
+  if(auto w = pt::this_worker; w && w->_executor == this) {
+    return w->_domain;
+  }
+  auto cpu = NumaTopology::current_cpu();
+  return (cpu >= 0 && static_cast<size_t>(cpu) < _cpu_domains.size()) ? _cpu_domains[cpu] : 0;
+}
+
 // Destructor
 inline Executor::~Executor() {
 
   // wait for all topologies to complete
   wait_for_all();
 
+  // stop the elastic controller so that no worker is resumed or parked anymore
+  if(_elastic_thread.joinable()) {
+    {
+      std::scoped_lock lock(_park_mutex);
+      _elastic_stop = true;
+    }
+    _elastic_cv.notify_one();
+    _elastic_thread.join();
+  }
+
   // shut down the scheduler
   for(size_t i=0; i<_workers.size(); ++i) {
   #if __cplusplus >= TF_CPP20
@@ -1170,6 +1606,12 @@ inline Executor::~Executor() {
 
   _notifier.notify_all();
 
+  // parked workers check their done flag under the park mutex
+  {
+    std::scoped_lock lock(_park_mutex);
+    _park_cv.notify_all();
+  }
+
   for(auto& w : _workers) {
     w._thread.join();
   }
@@ -1216,9 +1658,262 @@ inline int Executor::this_worker_id() const {
   return (w && w->_executor == this) ? static_cast<int>(w->_id) : -1;
 }
 
+// Procedure: set_idle_policy
+inline void Executor::set_idle_policy(const IdlePolicy& policy) {
+  if(policy.min_yields > policy.max_yields) {
+    TF_THROW("idle policy min_yields (", policy.min_yields,
+             ") exceeds max_yields (", policy.max_yields, ")");
+  }
+  std::scoped_lock lock(_idle_mutex);
+  _idle_policy = policy;
+  _idle_epoch.fetch_add(1, std::memory_order_release);
+}
+
+// Function: idle_policy
+inline IdlePolicy Executor::idle_policy() const {
+  std::scoped_lock lock(_idle_mutex);
+  return _idle_policy;
+}
+
+// Function: idle_stats
+inline IdleStats Executor::idle_stats() const {
+  IdleStats stats;
+  for(auto& w : _workers) {
+    stats += w.idle_stats();
+  }
+  return stats;
+}
+
+// Function: metrics
+inline ExecutorMetrics Executor::metrics() const {
+
+  ExecutorMetrics metrics;
+  metrics.workers.reserve(_workers.size());
+
+  std::array<size_t, TASK_TYPES.size()> tasks {};
+  std::array<MetricsCounters::Buckets, TASK_TYPES.size()> counts {};
+  std::array<uint64_t, TASK_TYPES.size()> ticks {};
+
+  for(auto& w : _workers) {
+    auto m = w._metrics.load(tasks, counts, ticks);
+    auto idle = w.idle_stats();
+    m.num_sleeps = idle.num_sleeps;
+    m.explore_time = idle.spin + idle.yield;
+    m.sleep_time = idle.sleep;
+    metrics.workers.push_back(m);
+  }
+
+  // estimate the tick length from the clock pair taken at construction,
+  // and fix it once the estimate spans 100 ms so that bucket bounds no
+  // longer move between snapshots
+  double ns_per_tick = _ns_per_tick.load(std::memory_order_relaxed);
+  if(ns_per_tick == 0.0) {
+    auto tsc = read_tsc();
+    auto elapsed = observer_stamp_t::clock::now() - _origin_time;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    ns_per_tick = (tsc > _origin_tsc) ? double(ns) / double(tsc - _origin_tsc) : 1.0;
+    if(elapsed >= std::chrono::milliseconds(100)) {
+      _ns_per_tick.store(ns_per_tick, std::memory_order_relaxed);
+    }
+  }
+
+  for(size_t t=0; t<TASK_TYPES.size(); ++t) {
+    metrics.task_durations[t] = MetricsCounters::histogram(tasks[t], counts[t], ticks[t], ns_per_tick);
+  }
+
+  return metrics;
+}
+
+// Function: _refresh_idle_policy
+// Only the epoch is read on the common path; the mutex is taken when a
+// worker sees that set_idle_policy has run since its last copy.
+TF_FORCE_INLINE const IdlePolicy& Executor::_refresh_idle_policy(Worker& w) {
+  if(auto epoch = _idle_epoch.load(std::memory_order_acquire); epoch != w._idle_epoch) {
+    std::scoped_lock lock(_idle_mutex);
+    w._idle_policy = _idle_policy;
+    w._idle_epoch = epoch;
+  }
+  return w._idle_policy;
+}
+
+// Function: _yield_budget
+// Number of failed steals with a yield a worker makes before it sleeps; in
+// the adaptive mode it moves with the worker's recent steal success rate.
+TF_FORCE_INLINE size_t Executor::_yield_budget(Worker& w) const {
+  auto& p = w._idle_policy;
+  if(!p.adaptive) {
+    return p.max_yields;
+  }
+  return p.min_yields + ((p.max_yields - p.min_yields) * w._steal_rate >> 10);
+}
+
+// Function: num_active_workers
+inline size_t Executor::num_active_workers() const noexcept {
+  return _num_active.load(std::memory_order_relaxed);
+}
+
+// Function: elastic_stats
+inline ElasticStats Executor::elastic_stats() const {
+  std::scoped_lock lock(_park_mutex);
+  auto stats = _elastic_stats;
+  stats.num_active_workers = _num_active.load(std::memory_order_relaxed);
+  return stats;
+}
+
+// Function: _elastic_num_workers
+inline size_t Executor::_elastic_num_workers(const ElasticPolicy& policy) {
+  size_t N = policy.max_workers ? policy.max_workers : std::thread::hardware_concurrency();
+  if(policy.min_workers == 0) {
+    TF_THROW("elastic executor must keep at least one worker active");
+  }
+  if(policy.min_workers > N) {
+    TF_THROW("elastic policy min_workers (", policy.min_workers,
+             ") exceeds max_workers (", N, ")");
+  }
+  return N;
+}
+
+// Function: _park
+// Blocks a worker that is beyond the active count until the controller
+// raises the count past it (true) or the executor shuts down (false).
+// A non-default _resize_time means the controller asked for the transition,
+// which then counts toward the elastic statistics.
+inline bool Executor::_park(Worker& w) {
+
+  using clock = std::chrono::steady_clock;
+
+  auto record = [&](std::chrono::nanoseconds& total, std::chrono::nanoseconds& max) {
+    if(auto& t = _resize_time[w._id]; t != clock::time_point{}) {
+      auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - t);
+      total += d;
+      max = std::max(max, d);
+      t = clock::time_point{};
+    }
+  };
+
+  auto done = [&](){
+  #if __cplusplus >= TF_CPP20
+    return w._done.test(std::memory_order_relaxed);
+  #else
+    return w._done.load(std::memory_order_relaxed);
+  #endif
+  };
+
+  std::unique_lock lock(_park_mutex);
+
+  _parked[w._id] = true;
+  record(_elastic_stats.shrink_latency, _elastic_stats.max_shrink_latency);
+
+  _park_cv.wait(lock, [&](){
+    return w._id < _num_active.load(std::memory_order_relaxed) || done();
+  });
+
+  _parked[w._id] = false;
+  record(_elastic_stats.grow_latency, _elastic_stats.max_grow_latency);
+
+  return !done();
+}
+
+// Procedure: _set_num_active
+// Moves the active count to n; the caller holds _park_mutex. Resumed
+// workers are woken up from _park_cv, and workers to park are woken up
+// from the notifier in case they sleep there, so that they park right away.
+// A worker resumed before it has parked adds no latency.
+inline void Executor::_set_num_active(size_t n) {
+
+  auto now = std::chrono::steady_clock::now();
+  auto a = _num_active.load(std::memory_order_relaxed);
+
+  if(n > a) {
+    // a worker that has not parked yet simply keeps running
+    for(size_t id=a; id<n; ++id) {
+      _resize_time[id] = _parked[id] ? now : std::chrono::steady_clock::time_point{};
+    }
+    _elastic_stats.num_grows += n - a;
+    _num_active.store(n, std::memory_order_release);
+    _park_cv.notify_all();
+  }
+  else if(n < a) {
+    for(size_t id=n; id<a; ++id) {
+      _resize_time[id] = now;
+    }
+    _elastic_stats.num_shrinks += a - n;
+    _num_active.store(n, std::memory_order_release);
+    _notifier.notify_all();
+  }
+}
+
+// Procedure: _elastic_loop
+// Every interval, the controller adds a worker when more than grow_depth
+// tasks per active worker are queued, and parks one after shrink_after
+// consecutive intervals in which the active workers were idle (yielding
+// or sleeping) for more than shrink_idle of the time.
+inline void Executor::_elastic_loop() {
+
+  using clock = IdleCounters::clock;
+
+  const auto& p = _elastic_policy;
+  const size_t W = _workers.size();
+
+  auto last = clock::now();
+  std::vector<clock::duration> idle(W);
+  for(size_t i=0; i<W; ++i) {
+    idle[i] = _workers[i]._idle_counters.idle(last);
+  }
+
+  size_t num_idle_intervals = 0;
+
+  std::unique_lock lock(_park_mutex);
+
+  while(!_elastic_cv.wait_for(lock, p.interval, [this](){ return _elastic_stop; })) {
+
+    lock.unlock();
+
+    auto active = _num_active.load(std::memory_order_relaxed);
+
+    size_t depth = 0;
+    for(size_t i=0; i<W; ++i) {
+      depth += _workers[i]._wsq.size();
+    }
+    for(size_t b=0; b<_buffers.size(); ++b) {
+      depth += _buffers.size(b);
+    }
+
+    auto now = clock::now();
+    clock::duration idled {0};
+    for(size_t i=0; i<W; ++i) {
+      auto t = _workers[i]._idle_counters.idle(now);
+      if(i < active) {
+        idled += t - idle[i];
+      }
+      idle[i] = t;
+    }
+    double fraction = static_cast<double>(idled.count()) / (active * (now - last).count());
+    last = now;
+
+    lock.lock();
+
+    if(depth > p.grow_depth * active && active < W) {
+      _set_num_active(active + 1);
+      num_idle_intervals = 0;
+    }
+    else if(fraction > p.shrink_idle && active > p.min_workers) {
+      if(++num_idle_intervals >= p.shrink_after) {
+        _set_num_active(active - 1);
+        num_idle_intervals = 0;
+      }
+    }
+    else {
+      num_idle_intervals = 0;
+    }
+  }
+}
+
 // Procedure: _spawn
 inline void Executor::_spawn(size_t N) {
 
+  _num_active.store(N, std::memory_order_relaxed);
+
   for(size_t id=0; id<N; ++id) {
 
     _workers[id]._id = id;
@@ -1234,6 +1929,13 @@ inline void Executor::_spawn(size_t N) {
         std::hash<std::thread::id>()(std::this_thread::get_id()))
       );
 
+      // bind to the CPUs of this worker's cluster under a NUMA topology;
+      // a failed bind leaves Worker::cpus empty
+      if(!_worker_cpus.empty() &&
+         NumaTopology::bind_this_thread(_worker_cpus[w._id])) {
+        w._cpus = _worker_cpus[w._id];
+      }
+
       // before entering the work-stealing loop, call the scheduler prologue
       if(_worker_interface) {
         _worker_interface->scheduler_prologue(w);
@@ -1276,9 +1978,9 @@ inline void Executor::_spawn(size_t N) {
 template <typename P>
 void Executor::_corun_until(Worker& w, P&& stop_predicate) {
 
-  const size_t MAX_STEALS = ((num_queues() + 1) << 1);
-    
-  std::uniform_int_distribution<size_t> udist(0, num_queues()-1);
+  // a corunning worker cannot sleep, so only the spin phase of the idle
+  // policy applies before it starts yielding
+  const size_t MAX_STEALS = _refresh_idle_policy(w).spin_rounds * ((num_queues() + 1) << 1);
   
   exploit:
 
@@ -1295,8 +1997,7 @@ void Executor::_corun_until(Worker& w, P&& stop_predicate) {
       
       //auto vtm = udist(w._rdgen);
 
-      t = (vtm < _workers.size()) ? _workers[vtm]._wsq.steal() : 
-                                    _buffers.steal(vtm - _workers.size());
+      t = _steal(w, vtm);
 
       if(t) {
         _invoke(w, t);
@@ -1307,7 +2008,7 @@ void Executor::_corun_until(Worker& w, P&& stop_predicate) {
         if(++num_steals > MAX_STEALS) {
           std::this_thread::yield();
         }
-        vtm = udist(w._rdgen);
+        vtm = _next_victim(w, num_steals);
         goto explore;
       }
       else {
@@ -1318,15 +2019,24 @@ void Executor::_corun_until(Worker& w, P&& stop_predicate) {
 }
 
 // Function: _explore_task
+// Failed steals go through the spin and yield phases of the worker's idle
+// policy (see tf::IdlePolicy); returning with a null task sends the worker
+// to the sleep phase in _wait_for_task. The clock is read only once the
+// first steal has failed, so a successful first steal costs nothing extra.
 inline bool Executor::_explore_task(Worker& w, Node*& t) {
 
   //assert(!t);
+
+  using clock = IdleCounters::clock;
   
-  const size_t MAX_STEALS = ((num_queues() + 1) << 1);
-  std::uniform_int_distribution<size_t> udist(0, num_queues()-1);
+  const auto& policy = _refresh_idle_policy(w);
+  const size_t MAX_SPINS = policy.spin_rounds * ((num_queues() + 1) << 1);
+  const size_t MAX_STEALS = MAX_SPINS + _yield_budget(w);
 
   size_t num_steals = 0;
+  size_t num_pauses = 1;
   size_t vtm = w._vtm;
+  clock::time_point beg, mid;
 
   // Make the worker steal immediately from the assigned victim.
   while(true) {
@@ -1336,22 +2046,33 @@ inline bool Executor::_explore_task(Worker& w, Node*& t) {
 
     // If the worker's victim thread is within the worker pool, steal from the worker's queue.
     // Otherwise, steal from the buffer, adjusting the victim index based on the worker pool size.
-    t = (vtm < _workers.size())
-      ? _workers[vtm]._wsq.steal()
-      : _buffers.steal(vtm - _workers.size());
+    t = _steal(w, vtm);
 
     if(t) {
       w._vtm = vtm;
+      w._metrics.add_steal();
       break;
     }
 
-    // Increment the steal count, and if it exceeds MAX_STEALS, yield the thread.
-    // If the number of *consecutive* empty steals reaches MAX_STEALS, exit the loop.
-    if (++num_steals > MAX_STEALS) {
-      std::this_thread::yield();
-      if(num_steals > 100 + MAX_STEALS) {
+    if(num_steals == 0) {
+      beg = clock::now();
+    }
+
+    // Spin up to MAX_SPINS consecutive empty steals, pausing with exponential
+    // backoff if the policy asks for it, then yield after each empty steal
+    // until MAX_STEALS is reached and the worker goes to sleep.
+    if(++num_steals > MAX_SPINS) {
+      if(num_steals == MAX_SPINS + 1) {
+        mid = clock::now();
+      }
+      if(num_steals > MAX_STEALS) {
         break;
       }
+      std::this_thread::yield();
+    }
+    else if(policy.max_pause) {
+      pause(num_pauses);
+      num_pauses = std::min(num_pauses << 1, policy.max_pause);
     }
 
   #if __cplusplus >= TF_CPP20
@@ -1362,8 +2083,26 @@ inline bool Executor::_explore_task(Worker& w, Node*& t) {
       return false;
     } 
 
-    vtm = udist(w._rdgen); //w._rdvtm();
+    // Pick the next victim, preferring queues close to this worker.
+    vtm = _next_victim(w, num_steals);
   } 
+
+  if(num_steals) {
+    w._metrics.add_failed_steals(num_steals);
+    auto end = clock::now();
+    if(num_steals > MAX_SPINS) {
+      w._idle_counters.add_spin(mid - beg);
+      w._idle_counters.add_yield(end - mid);
+      // moving average of whether yielding ended in a steal or in a sleep
+      if(policy.adaptive) {
+        w._steal_rate = w._steal_rate - (w._steal_rate >> 3) + (t ? 128 : 0);
+      }
+    }
+    else {
+      w._idle_counters.add_spin(end - beg);
+    }
+  }
+
   return true;
 }
 
@@ -1371,7 +2110,34 @@ inline bool Executor::_explore_task(Worker& w, Node*& t) {
 inline void Executor::_exploit_task(Worker& w, Node*& t) {
   while(t) {
     _invoke(w, t);
-    t = w._wsq.pop();
+    if(t = w._wsq.pop(); t) {
+      _serve_buffers(w, t);
+    }
+  }
+}
+
+// Procedure: _serve_buffers
+// A busy worker never explores, so nodes in the buffers could wait behind
+// its local queue indefinitely. Before running the local node t, a worker
+// swaps it for a buffered node (putting t back) when a high-priority node
+// is buffered and t is not high-priority, and otherwise tries one bucket in
+// turn on every TF_TASK_PRIORITY_AGING-th local node. The common case costs
+// one relaxed load and a counter increment.
+TF_FORCE_INLINE void Executor::_serve_buffers(Worker& w, Node*& t) {
+  Node* u = nullptr;
+  if(t->_priority != TaskPriority::HIGH &&
+     _num_buffered_high.load(std::memory_order_relaxed) != 0) {
+    u = _steal_buffered_high(w);
+  }
+  else if(++w._num_pops % TF_TASK_PRIORITY_AGING == 0) {
+    u = _steal(w, _workers.size() + (w._num_pops / TF_TASK_PRIORITY_AGING) % _buffers.size());
+  }
+  if(u) {
+    w._wsq.push(t, static_cast<size_t>(t->_priority), [&](){
+      w._metrics.add_overflow();
+      _push_to_buffers(t, w._domain);
+    });
+    t = u;
   }
 }
 
@@ -1386,15 +2152,24 @@ inline bool Executor::_wait_for_task(Worker& w, Node*& t) {
   
   // Go exploit the task if we successfully steal one.
   if(t) {
+    if(w._woken) {
+      w._woken = false;
+      w._metrics.add_wakeup();
+    }
     return true;
   }
 
+#ifndef TF_DISABLE_NODE_ARENA
+  // hand back the nodes freed for other workers before going to sleep
+  _node_arena->flush(w._id);
+#endif
+
   // Entering the 2PC guard as all queues should be empty after many stealing attempts.
   _notifier.prepare_wait(w._waiter);
   
   // Condition #1: buffers should be empty
   for(size_t vtm=0; vtm<_buffers.size(); ++vtm) {
-    if(!_buffers._buckets[vtm].queue.empty()) {
+    if(!_buffers.empty(vtm)) {
       _notifier.cancel_wait(w._waiter);
       w._vtm = vtm + _workers.size();
       goto explore_task;
@@ -1431,9 +2206,25 @@ inline bool Executor::_wait_for_task(Worker& w, Node*& t) {
     _notifier.cancel_wait(w._waiter);
     return false;
   }
+
+  // Condition #4: worker should not be parked by the elastic controller;
+  // all queues are empty here, so parking strands no task, and a
+  // notification this worker may have absorbed is handed on
+  if(w._id >= _num_active.load(std::memory_order_acquire)) {
+    _notifier.cancel_wait(w._waiter);
+    _notifier.notify_one();
+    if(_park(w) == false) {
+      return false;
+    }
+    goto explore_task;
+  }
   
   // Now I really need to relinquish myself to others.
+  auto beg = IdleCounters::clock::now();
+  w._idle_counters.begin_sleep(beg);
   _notifier.commit_wait(w._waiter);
+  w._idle_counters.add_sleep(IdleCounters::clock::now() - beg);
+  w._woken = true;
   goto explore_task;
 }
 
@@ -1480,19 +2271,22 @@ inline void Executor::_schedule(Worker& worker, Node* node) {
   // any complicated notification mechanism as the experimental result
   // has shown no significant advantage.
   if(worker._executor == this) {
-    worker._wsq.push(node, [&](){ _buffers.push(node); });
+    worker._wsq.push(node, static_cast<size_t>(node->_priority), [&](){
+      worker._metrics.add_overflow();
+      _push_to_buffers(node, worker._domain);
+    });
     _notifier.notify_one();
     return;
   }
   
   // caller is not a worker of this executor - go through the centralized queue
-  _buffers.push(node);
+  _push_to_buffers(node, _this_domain());
   _notifier.notify_one();
 }
 
 // Procedure: _schedule
 inline void Executor::_schedule(Node* node) {
-  _buffers.push(node);
+  _push_to_buffers(node, _this_domain());
   _notifier.notify_one();
 }
 
@@ -1511,18 +2305,32 @@ void Executor::_schedule(Worker& worker, I first, I last) {
   // immediately. If v is the last node in the graph, it will tear down the parent task vector
   // which cause the last ++first to fail. This problem is specific to MSVC which has a stricter
   // iterator implementation in std::vector than GCC/Clang.
+  // A worker publishes each run of equal-priority nodes to the lane of that
+  // priority with one bottom store; nodes that do not fit spill to the
+  // buffers, advancing the iterator before each push for the reason above.
+  // The end of the next run is found before the current run is published,
+  // so nothing is read from the range after its last node is published.
   if(worker._executor == this) {
-    for(size_t i=0; i<num_nodes; i++) {
-      auto node = detail::get_node_ptr(first[i]);
-      worker._wsq.push(node, [&](){ _buffers.push(node); });
-      _notifier.notify_one();
+    for(size_t i=0, j; i<num_nodes; i=j) {
+      auto p = static_cast<size_t>(detail::get_node_ptr(first[i])->_priority);
+      for(j=i+1; j<num_nodes && static_cast<size_t>(detail::get_node_ptr(first[j])->_priority) == p; ++j);
+      worker._wsq.bulk_push(detail::NodePtrIterator<I>{first + i}, j - i, p, [&](auto it, size_t n){
+        for(size_t k=0; k<n; ++k) {
+          auto node = *it;
+          ++it;
+          worker._metrics.add_overflow();
+          _push_to_buffers(node, worker._domain);
+        }
+      });
     }
+    _notifier.notify_n(num_nodes);
     return;
   }
   
   // caller is not a worker of this executor - go through the centralized queue
+  auto domain = _this_domain();
   for(size_t i=0; i<num_nodes; i++) {
-    _buffers.push(detail::get_node_ptr(first[i]));
+    _push_to_buffers(detail::get_node_ptr(first[i]), domain);
   }
   _notifier.notify_n(num_nodes);
 }
@@ -1542,8 +2350,9 @@ inline void Executor::_schedule(I first, I last) {
   // immediately. If v is the last node in the graph, it will tear down the parent task vector
   // which cause the last ++first to fail. This problem is specific to MSVC which has a stricter
   // iterator implementation in std::vector than GCC/Clang.
+  auto domain = _this_domain();
   for(size_t i=0; i<num_nodes; i++) {
-    _buffers.push(detail::get_node_ptr(first[i]));
+    _push_to_buffers(detail::get_node_ptr(first[i]), domain);
   }
   _notifier.notify_n(num_nodes);
 }
@@ -1555,8 +2364,13 @@ void Executor::_schedule_graph_with_parent(Worker& worker, I beg, I end, Node* p
   _schedule(worker, beg, send);
 }
 
+// The more urgent of the two nodes stays as the continuation; on a tie the
+// newer one does.
 TF_FORCE_INLINE void Executor::_update_cache(Worker& worker, Node*& cache, Node* node) {
   if(cache) {
+    if(node->_priority > cache->_priority) {
+      std::swap(node, cache);
+    }
     _schedule(worker, cache);
   }
   cache = node;
@@ -1588,7 +2402,7 @@ inline void Executor::_invoke(Worker& worker, Node* node) {
   }
 
   // if acquiring semaphore(s) exists, acquire them first
-  if(node->_semaphores && !node->_semaphores->to_acquire.empty()) {
+  if(node->_cold && !node->_cold->semaphores.to_acquire.empty()) {
     SmallVector<Node*> waiters;
     if(!node->_acquire_all(waiters)) {
       _schedule(worker, waiters.begin(), waiters.end());
@@ -1672,7 +2486,7 @@ inline void Executor::_invoke(Worker& worker, Node* node) {
   }
 
   // if releasing semaphores exist, release them
-  if(node->_semaphores && !node->_semaphores->to_release.empty()) {
+  if(node->_cold && !node->_cold->semaphores.to_release.empty()) {
     SmallVector<Node*> waiters;
     node->_release_all(waiters);
     _schedule(worker, waiters.begin(), waiters.end());
@@ -1711,13 +2525,30 @@ inline void Executor::_invoke(Worker& worker, Node* node) {
     break;
 
     // non-condition task
+    // The most urgent ready successor (the last one among equals) is cached
+    // as the continuation; the others are collected and scheduled in batches
+    // so a wide fan-out costs one queue publication and one notify_n per batch.
     default: {
+      constexpr size_t BATCH = 32;
+      Node* ready[BATCH];
+      size_t num_ready = 0;
       for(size_t i=0; i<node->_num_successors; ++i) {
         if(auto s = node->_edges[i]; s->_join_counter.fetch_sub(1, std::memory_order_acq_rel) == 1) {
           join_counter.fetch_add(1, std::memory_order_relaxed);
-          _update_cache(worker, cache, s);
+          if(cache) {
+            if(s->_priority > cache->_priority) {
+              std::swap(s, cache);
+            }
+            ready[num_ready++] = cache;
+            if(num_ready == BATCH) {
+              _schedule(worker, ready, ready + num_ready);
+              num_ready = 0;
+            }
+          }
+          cache = s;
         }
       }
+      _schedule(worker, ready, ready + num_ready);
     }
     break;
   }
@@ -1749,15 +2580,19 @@ inline void Executor::_tear_down_invoke(Worker& worker, Node* node, Node*& cache
   }
 }
 
-// Procedure: _observer_prologue
-inline void Executor::_observer_prologue(Worker& worker, Node* node) {
+// Function: _observer_prologue
+// Returns the start of the task if the worker's metrics time it, taken
+// after the observers so that their cost is not counted.
+inline uint64_t Executor::_observer_prologue(Worker& worker, Node* node) {
   for(auto& observer : _observers) {
     observer->on_entry(WorkerView(worker), TaskView(*node));
   }
+  return worker._metrics.begin_task();
 }
 
 // Procedure: _observer_epilogue
-inline void Executor::_observer_epilogue(Worker& worker, Node* node) {
+inline void Executor::_observer_epilogue(Worker& worker, Node* node, uint64_t beg) {
+  worker._metrics.end_task(TaskView(*node).type(), beg);
   for(auto& observer : _observers) {
     observer->on_exit(WorkerView(worker), TaskView(*node));
   }
@@ -1782,7 +2617,7 @@ inline void Executor::_process_exception(Worker&, Node* node) {
   if(anchor) {
     // multiple tasks may throw, and we only take the first thrown exception
     if((anchor->_estate.fetch_or(flag, std::memory_order_relaxed) & ESTATE::EXCEPTION) == 0) {
-      anchor->_exception_ptr = std::current_exception();
+      anchor->_cold_data().exception_ptr = std::current_exception();
       return;
     }
   }
@@ -1798,16 +2633,16 @@ inline void Executor::_process_exception(Worker&, Node* node) {
   // for now, we simply store the exception in this node; this can happen in an 
   // execution that does not have any external control to capture the exception,
   // such as silent async task
-  node->_exception_ptr = std::current_exception();
+  node->_cold_data().exception_ptr = std::current_exception();
 }
 
 // Procedure: _invoke_static_task
 inline void Executor::_invoke_static_task(Worker& worker, Node* node) {
-  _observer_prologue(worker, node);
+  auto beg = _observer_prologue(worker, node);
   TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
     std::get_if<Node::Static>(&node->_handle)->work();
   });
-  _observer_epilogue(worker, node);
+  _observer_epilogue(worker, node, beg);
 }
 
 // Procedure: _invoke_subflow_task
@@ -1822,11 +2657,11 @@ inline bool Executor::_invoke_subflow_task(Worker& worker, Node* node) {
     Subflow sf(*this, worker, node, g);
 
     // invoke the subflow callable
-    _observer_prologue(worker, node);
+    auto beg = _observer_prologue(worker, node);
     TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
       h.work(sf);
     });
-    _observer_epilogue(worker, node);
+    _observer_epilogue(worker, node, beg);
     
     // spawn the subflow if it is joinable and its graph is non-empty
     // implicit join is faster than Subflow::join as it does not involve corun
@@ -1856,23 +2691,23 @@ inline bool Executor::_invoke_subflow_task(Worker& worker, Node* node) {
 inline void Executor::_invoke_condition_task(
   Worker& worker, Node* node, SmallVector<int>& conds
 ) {
-  _observer_prologue(worker, node);
+  auto beg = _observer_prologue(worker, node);
   TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
     auto& work = std::get_if<Node::Condition>(&node->_handle)->work;
     conds = { work() };
   });
-  _observer_epilogue(worker, node);
+  _observer_epilogue(worker, node, beg);
 }
 
 // Procedure: _invoke_multi_condition_task
 inline void Executor::_invoke_multi_condition_task(
   Worker& worker, Node* node, SmallVector<int>& conds
 ) {
-  _observer_prologue(worker, node);
+  auto beg = _observer_prologue(worker, node);
   TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
     conds = std::get_if<Node::MultiCondition>(&node->_handle)->work();
   });
-  _observer_epilogue(worker, node);
+  _observer_epilogue(worker, node, beg);
 }
 
 // Procedure: _invoke_module_task
@@ -1908,12 +2743,13 @@ inline bool Executor::_invoke_async_task(Worker& worker, Node* node) {
   auto& work = std::get_if<Node::Async>(&node->_handle)->work;
   switch(work.index()) {
     // void()
-    case 0:
-      _observer_prologue(worker, node);
+    case 0: {
+      auto beg = _observer_prologue(worker, node);
       TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
         std::get_if<0>(&work)->operator()();
       });
-      _observer_epilogue(worker, node);
+      _observer_epilogue(worker, node, beg);
+    }
     break;
     
     // void(Runtime&)
@@ -1939,12 +2775,13 @@ inline bool Executor::_invoke_dependent_async_task(Worker& worker, Node* node) {
   auto& work = std::get_if<Node::DependentAsync>(&node->_handle)->work;
   switch(work.index()) {
     // void()
-    case 0:
-      _observer_prologue(worker, node);
+    case 0: {
+      auto beg = _observer_prologue(worker, node);
       TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
         std::get_if<0>(&work)->operator()();
       });
-      _observer_epilogue(worker, node);
+      _observer_epilogue(worker, node, beg);
+    }
     break;
     
     // void(Runtime&) - silent async
@@ -2190,7 +3027,9 @@ I Executor::_set_up_graph(I first, I last, Topology* tpg, Node* parent) {
     node->_nstate = NSTATE::NONE;
     node->_estate.store(ESTATE::NONE, std::memory_order_relaxed);
     node->_set_up_join_counter();
-    node->_exception_ptr = nullptr;
+    if(node->_cold) {
+      node->_cold->exception_ptr = nullptr;
+    }
 
     // move source to the first partition
     // root, root, root, v1, v2, v3, v4, ...
@@ -1,52 +1,199 @@
 #pragma once
 
 #include "tsq.hpp"
+#include "../utility/mpmc.hpp"
+
+#ifndef TF_DEFAULT_FREELIST_BUCKET_LOG_SIZE
+  /**
+  @def TF_DEFAULT_FREELIST_BUCKET_LOG_SIZE
+
+  This macro defines the size, in Log2, of the lock-free ring of each
+  freelist bucket. Items beyond it spill into a locked overflow queue.
+  */
+  #define TF_DEFAULT_FREELIST_BUCKET_LOG_SIZE 10
+#endif
+
+#ifndef TF_FREELIST_OVERFLOW_AGING
+  /**
+  @def TF_FREELIST_OVERFLOW_AGING
+
+  This macro defines how often a thief serves the overflow queue of a
+  freelist lane first: one in every TF_FREELIST_OVERFLOW_AGING steals a
+  thread makes from lanes with a non-empty overflow queue, so items that
+  spilled cannot starve while producers keep refilling the ring.
+  */
+  #define TF_FREELIST_OVERFLOW_AGING 16
+#endif
 
 namespace tf {
 
+namespace pt {
+
+/**
+@private
+*/
+inline thread_local size_t freelist_shard {static_cast<size_t>(-1)};
+
+/**
+@private
+*/
+inline thread_local size_t freelist_overflow_steals {0};
+
+}
+
 /**
 @private
 */
-template <typename T>
+template <typename T, size_t P = 1>
 class Freelist {
 
   friend class Executor;
 
   public:
-  struct Bucket {
+
+  // Producers enqueue into a bounded lock-free MPMC ring; only when the ring
+  // is full does an item take the mutex and go to the overflow queue. Thieves
+  // try the ring first and then steal from the overflow queue, which needs no
+  // lock on their side, except that every TF_FREELIST_OVERFLOW_AGING-th steal
+  // tries the overflow queue first so spilled items keep moving.
+  struct Lane {
+    MPMC<T, TF_DEFAULT_FREELIST_BUCKET_LOG_SIZE> ring;
     std::mutex mutex;
-    UnboundedTaskQueue<T> queue;
-  };  
-  
+    UnboundedTaskQueue<T> overflow;
+  };
+
+  // One lane per priority, lane 0 being the highest.
+  struct Bucket {
+    Lane lanes[P];
+  };
+
   // Here, we don't create just N task queues in the freelist as it will cause
   // the work-stealing loop to spand a lot of time on stealing tasks.
   // Experimentally speaking, we found floor_log2(N) is the best.
-  TF_FORCE_INLINE Freelist(size_t N) : _buckets(N < 4 ? 1 : floor_log2(N)) {}
+  TF_FORCE_INLINE Freelist(size_t N) : Freelist(std::vector<size_t>{N}) {}
 
-  // Pointers are aligned to 8 bytes. We perform a simple hash to avoid contention caused
-  // by hashing to the same slot.
+  // One group of buckets per NUMA domain, sized by the number of workers in
+  // that domain, so an item pushed with a domain stays in memory close to it.
+  Freelist(const std::vector<size_t>& workers_per_domain) {
+    size_t num_buckets = 0;
+    for(auto n : workers_per_domain) {
+      _domains.push_back(num_buckets);
+      num_buckets += (n < 4 ? 1 : floor_log2(n));
+    }
+    _domains.push_back(num_buckets);
+    _buckets = std::vector<Bucket>(num_buckets);
+  }
+
+  // Each producer thread is given a shard on first use, round-robin, so
+  // concurrent producers spread evenly over the buckets instead of
+  // colliding on whichever bucket their item addresses happen to hash to.
   TF_FORCE_INLINE void push(T item) {
-    //auto b = reinterpret_cast<uintptr_t>(item) % _buckets.size();
-    auto b = (reinterpret_cast<uintptr_t>(item) >> 16) % _buckets.size();
-    std::scoped_lock lock(_buckets[b].mutex);
-    _buckets[b].queue.push(item);
+    _push(_buckets[_shard() % _buckets.size()].lanes[0], item);
   }
 
-  TF_FORCE_INLINE T steal(size_t w) {
-    return _buckets[w].queue.steal();
+  // Same as above but restricted to the buckets of domain d, in lane p.
+  TF_FORCE_INLINE void push(T item, size_t d, size_t p = 0) {
+    auto beg = _domains[d];
+    _push(_buckets[beg + _shard() % (_domains[d+1] - beg)].lanes[p], item);
   }
-  
+
+  // Takes from the highest-priority non-empty lane, or from the lowest one
+  // when aged, mirroring PriorityTaskQueue::steal.
+  TF_FORCE_INLINE T steal(size_t w, bool aged = false) {
+    for(size_t i=0; i<P; ++i) {
+      if(auto item = _steal(_buckets[w].lanes[aged ? P-1-i : i]); item) {
+        return item;
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes from lane p of bucket w only.
+  TF_FORCE_INLINE T steal_lane(size_t w, size_t p) {
+    return _steal(_buckets[w].lanes[p]);
+  }
+
   TF_FORCE_INLINE T steal_with_hint(size_t w, size_t& num_empty_steals) {
-    return _buckets[w].queue.steal_with_hint(num_empty_steals);
+    if(auto item = steal(w); item) {
+      num_empty_steals = 0;
+      return item;
+    }
+    ++num_empty_steals;
+    return nullptr;
+  }
+
+  TF_FORCE_INLINE bool empty(size_t w) const {
+    for(size_t p=0; p<P; ++p) {
+      auto& lane = _buckets[w].lanes[p];
+      if(!lane.ring.empty() || !lane.overflow.empty()) {
+        return false;
+      }
+    }
+    return true;
   }
 
   TF_FORCE_INLINE size_t size() const {
     return _buckets.size();
   }
 
+  // approximate number of items in bucket w, over all lanes
+  TF_FORCE_INLINE size_t size(size_t w) const {
+    size_t n = 0;
+    for(size_t p=0; p<P; ++p) {
+      auto& lane = _buckets[w].lanes[p];
+      n += lane.ring.size() + lane.overflow.size();
+    }
+    return n;
+  }
+
+  TF_FORCE_INLINE size_t num_domains() const {
+    return _domains.size() - 1;
+  }
+
+  // buckets of domain d are [domain_begin(d), domain_end(d))
+  TF_FORCE_INLINE size_t domain_begin(size_t d) const {
+    return _domains[d];
+  }
+
+  TF_FORCE_INLINE size_t domain_end(size_t d) const {
+    return _domains[d+1];
+  }
+
   private:
-  
+
   std::vector<Bucket> _buckets;
+  std::vector<size_t> _domains;
+
+  TF_FORCE_INLINE static size_t _shard() {
+    static std::atomic<size_t> next {0};
+    if(pt::freelist_shard == static_cast<size_t>(-1)) {
+      pt::freelist_shard = next.fetch_add(1, std::memory_order_relaxed);
+    }
+    return pt::freelist_shard;
+  }
+
+  // The overflow queue holds items that spilled while the ring was full, so
+  // they are usually older than what producers put in the ring since; the
+  // count is per thread to keep thieves off a shared counter.
+  TF_FORCE_INLINE static T _steal(Lane& lane) {
+    if(!lane.overflow.empty() &&
+       ++pt::freelist_overflow_steals % TF_FREELIST_OVERFLOW_AGING == 0) {
+      if(auto item = lane.overflow.steal(); item) {
+        return item;
+      }
+    }
+    if(auto item = lane.ring.try_dequeue(); item) {
+      return item;
+    }
+    return lane.overflow.steal();
+  }
+
+  TF_FORCE_INLINE static void _push(Lane& lane, T item) {
+    if(!lane.ring.try_enqueue(item)) {
+      std::scoped_lock lock(lane.mutex);
+      lane.overflow.push(item);
+    }
+  }
 };
 
 
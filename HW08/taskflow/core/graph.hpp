@@ -11,6 +11,7 @@
 #include "../utility/os.hpp"
 #include "../utility/math.hpp"
 #include "../utility/small_vector.hpp"
+#include "../utility/small_function.hpp"
 #include "../utility/serializer.hpp"
 #include "../utility/lazy_string.hpp"
 #include "error.hpp"
@@ -114,6 +115,11 @@ struct TaskParams {
   @brief C-styled pointer to user data
   */
   void* data {nullptr};
+
+  /**
+  @brief scheduling priority of the task
+  */
+  TaskPriority priority {TaskPriority::NORMAL};
 };
 
 /**
@@ -144,8 +150,14 @@ constexpr bool is_task_params_v =
 
 /**
 @private
+
+A node is aligned to a cache line and spans three of them: the fields read
+and written on the path from _invoke to releasing the successors come first,
+followed by the handle holding the callable; names, user data, semaphores
+and exceptions live in a side structure allocated on first use, so a node
+that uses none of them never touches it beyond a null check.
 */
-class Node {
+class alignas(TF_CACHELINE_SIZE) Node {
 
   friend class Graph;
   friend class Task;
@@ -174,7 +186,7 @@ class Node {
     template <typename C>
     Static(C&&);
 
-    std::function<void()> work;
+    SmallFunction<void()> work;
   };
   
   // runtime work handle
@@ -183,7 +195,7 @@ class Node {
     template <typename C>
     Runtime(C&&);
 
-    std::function<void(tf::Runtime&)> work;
+    SmallFunction<void(tf::Runtime&)> work;
   };
 
   // subflow work handle
@@ -192,7 +204,7 @@ class Node {
     template <typename C>
     Subflow(C&&);
 
-    std::function<void(tf::Subflow&)> work;
+    SmallFunction<void(tf::Subflow&)> work;
     Graph subgraph;
   };
 
@@ -202,7 +214,7 @@ class Node {
     template <typename C>
     Condition(C&&);
     
-    std::function<int()> work;
+    SmallFunction<int()> work;
   };
 
   // multi-condition work handle
@@ -211,7 +223,7 @@ class Node {
     template <typename C>
     MultiCondition(C&&);
 
-    std::function<SmallVector<int>()> work;
+    SmallFunction<SmallVector<int>()> work;
   };
 
   // module work handle
@@ -230,9 +242,9 @@ class Node {
     Async(T&&);
 
     std::variant<
-      std::function<void()>, 
-      std::function<void(tf::Runtime&)>,       // silent async
-      std::function<void(tf::Runtime&, bool)>  // async
+      SmallFunction<void()>, 
+      SmallFunction<void(tf::Runtime&)>,       // silent async
+      SmallFunction<void(tf::Runtime&, bool)>  // async
     > work;
   };
   
@@ -243,9 +255,9 @@ class Node {
     DependentAsync(C&&);
     
     std::variant<
-      std::function<void()>, 
-      std::function<void(tf::Runtime&)>,       // silent async
-      std::function<void(tf::Runtime&, bool)>  // async
+      SmallFunction<void()>, 
+      SmallFunction<void(tf::Runtime&)>,       // silent async
+      SmallFunction<void(tf::Runtime&, bool)>  // async
     > work;
    
     std::atomic<size_t> use_count {1};
@@ -269,6 +281,14 @@ class Node {
     SmallVector<Semaphore*> to_release;
   };
 
+  // fields rarely touched while scheduling, allocated on first write
+  struct Cold {
+    std::string name;
+    void* data {nullptr};
+    Semaphores semaphores;
+    std::exception_ptr exception_ptr {nullptr};
+  };
+
   public:
 
   // variant index
@@ -299,26 +319,27 @@ class Node {
 
   private:
   
+  // hot: scheduling state, in the first 104 bytes
   nstate_t _nstate              {NSTATE::NONE};
   std::atomic<estate_t> _estate {ESTATE::NONE};
 
-  std::string _name;
-  
-  void* _data {nullptr};
+  TaskPriority _priority {TaskPriority::NORMAL};
+  uint32_t _num_successors {0};
+
+  std::atomic<size_t> _join_counter {0};
   
   Topology* _topology {nullptr};
   Node* _parent {nullptr};
 
-  size_t _num_successors {0};
   SmallVector<Node*, 4> _edges;
 
-  std::atomic<size_t> _join_counter {0};
-  
+  std::unique_ptr<Cold> _cold;
+
+  // the callable fills the rest of the second line and the third
   handle_t _handle;
-  
-  std::unique_ptr<Semaphores> _semaphores;
-  
-  std::exception_ptr _exception_ptr {nullptr};
+
+  Cold& _cold_data();
+  std::exception_ptr _exception() const;
 
   bool _is_cancelled() const;
   bool _is_conditioner() const;
@@ -455,12 +476,16 @@ Node::Node(
 ) :
   _nstate       {nstate},
   _estate       {estate},
-  _name         {params.name},
-  _data         {params.data},
+  _priority     {params.priority},
+  _join_counter {join_counter},
   _topology     {topology},
   _parent       {parent},
-  _join_counter {join_counter},
   _handle       {std::forward<Args>(args)...} {
+  if(!params.name.empty() || params.data) {
+    auto& cold = _cold_data();
+    cold.name = params.name;
+    cold.data = params.data;
+  }
 }
 
 // Constructor
@@ -476,9 +501,9 @@ Node::Node(
 ) :
   _nstate       {nstate},
   _estate       {estate},
+  _join_counter {join_counter},
   _topology     {topology},
   _parent       {parent},
-  _join_counter {join_counter},
   _handle       {std::forward<Args>(args)...} {
 }
 
@@ -506,7 +531,7 @@ inline void Node::_remove_successors(Node* node) {
   size_t new_num_successors = std::distance(_edges.begin(), sit);
   std::move(_edges.begin() + _num_successors, _edges.end(), sit);
   _edges.resize(_edges.size() - (_num_successors - new_num_successors));
-  _num_successors = new_num_successors;
+  _num_successors = static_cast<uint32_t>(new_num_successors);
 }
 
 // Function: _remove_predecessors
@@ -546,7 +571,21 @@ inline size_t Node::num_strong_dependencies() const {
 
 // Function: name
 inline const std::string& Node::name() const {
-  return _name;
+  static const std::string empty;
+  return _cold ? _cold->name : empty;
+}
+
+// Function: _cold_data
+inline Node::Cold& Node::_cold_data() {
+  if(!_cold) {
+    _cold = std::make_unique<Cold>();
+  }
+  return *_cold;
+}
+
+// Function: _exception
+inline std::exception_ptr Node::_exception() const {
+  return _cold ? _cold->exception_ptr : nullptr;
 }
 
 // Function: _is_conditioner
@@ -582,17 +621,17 @@ inline void Node::_set_up_join_counter() {
 
 // Procedure: _rethrow_exception
 inline void Node::_rethrow_exception() {
-  if(_exception_ptr) {
-    auto e = _exception_ptr;
-    _exception_ptr = nullptr;
+  if(_cold && _cold->exception_ptr) {
+    auto e = _cold->exception_ptr;
+    _cold->exception_ptr = nullptr;
     std::rethrow_exception(e);
   }
 }
 
 // Function: _acquire_all
 inline bool Node::_acquire_all(SmallVector<Node*>& nodes) {
-  // assert(_semaphores != nullptr);
-  auto& to_acquire = _semaphores->to_acquire;
+  // assert(_cold != nullptr);
+  auto& to_acquire = _cold->semaphores.to_acquire;
   for(size_t i = 0; i < to_acquire.size(); ++i) {
     if(!to_acquire[i]->_try_acquire_or_wait(this)) {
       for(size_t j = 1; j <= i; ++j) {
@@ -606,8 +645,8 @@ inline bool Node::_acquire_all(SmallVector<Node*>& nodes) {
 
 // Function: _release_all
 inline void Node::_release_all(SmallVector<Node*>& nodes) {
-  // assert(_semaphores != nullptr);
-  auto& to_release = _semaphores->to_release;
+  // assert(_cold != nullptr);
+  auto& to_release = _cold->semaphores.to_release;
   for(const auto& sem : to_release) {
     sem->_release(nodes);
   }
@@ -733,6 +772,16 @@ TF_FORCE_INLINE Node* get_node_ptr(T& node) {
   }
 } 
 
+/**
+@private
+*/
+template <typename I>
+struct NodePtrIterator {
+  I it;
+  Node* operator*() const { return get_node_ptr(*it); }
+  NodePtrIterator& operator++() { ++it; return *this; }
+};
+
 }  // end of namespace tf::detail ---------------------------------------------
 
 
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+@file idle_policy.hpp
+@brief idle policy include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: IdlePolicy
+// ----------------------------------------------------------------------------
+
+/**
+@struct IdlePolicy
+
+@brief class to configure how an idle worker backs off before it sleeps
+
+When a worker runs out of local tasks it tries to steal from other queues.
+Consecutive failed steals go through three phases:
+
+  1. @em spin: up to <tt>spin_rounds * R</tt> failed steals back to back,
+     where @c R is twice the number of queues plus two; with a non-zero
+     @c max_pause, each failed steal is followed by a CPU pause whose
+     length doubles up to @c max_pause iterations
+  2. @em yield: up to @c max_yields further failed steals,
+     each followed by std::this_thread::yield
+  3. @em sleep: the worker waits on the executor's notifier
+     until new tasks are scheduled
+
+In the adaptive mode, each worker scales its yield budget between
+@c min_yields and @c max_yields by how often recently entering the
+yield phase ended with a successful steal rather than with a sleep,
+so bursty workloads keep workers awake between bursts while idle ones
+let them sleep early.
+
+@code{.cpp}
+tf::Executor executor;
+executor.set_idle_policy(tf::IdlePolicy::power_save());
+@endcode
+*/
+struct IdlePolicy {
+
+  /**
+  @brief rounds of back-to-back failed steals before yielding
+  */
+  size_t spin_rounds {1};
+
+  /**
+  @brief maximum number of CPU pauses between failed steals while spinning
+         (@c 0 disables the pause)
+  */
+  size_t max_pause {0};
+
+  /**
+  @brief minimum number of failed steals with a yield before sleeping
+         (used by the adaptive mode only)
+  */
+  size_t min_yields {100};
+
+  /**
+  @brief maximum number of failed steals with a yield before sleeping
+  */
+  size_t max_yields {100};
+
+  /**
+  @brief whether the yield budget adapts to the recent steal success rate
+  */
+  bool adaptive {false};
+
+  /**
+  @brief spins and yields for long before sleeping to minimize wake-up latency
+  */
+  static IdlePolicy latency() { return {64, 0, 10000, 10000, false}; }
+
+  /**
+  @brief the default policy: one round of spinning and up to 100 yields
+  */
+  static IdlePolicy balanced() { return {1, 0, 100, 100, false}; }
+
+  /**
+  @brief pauses between steals and sleeps right after one round of spinning
+  */
+  static IdlePolicy power_save() { return {1, 64, 0, 0, false}; }
+
+  /**
+  @brief learns the yield budget in <tt>[0, 1000]</tt> from recent steal outcomes
+  */
+  static IdlePolicy adaptive_backoff() { return {1, 16, 0, 1000, true}; }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: IdleStats
+// ----------------------------------------------------------------------------
+
+/**
+@struct IdleStats
+
+@brief class to report the time workers have spent idle in each phase of
+       tf::IdlePolicy
+*/
+struct IdleStats {
+
+  /**
+  @brief time spent on back-to-back failed steals
+  */
+  std::chrono::nanoseconds spin {0};
+
+  /**
+  @brief time spent on failed steals followed by a yield
+  */
+  std::chrono::nanoseconds yield {0};
+
+  /**
+  @brief time spent sleeping on the notifier
+  */
+  std::chrono::nanoseconds sleep {0};
+
+  /**
+  @brief number of completed sleeps, counted when a worker wakes up
+  */
+  size_t num_sleeps {0};
+
+  /**
+  @brief accumulates the statistics of another worker
+  */
+  IdleStats& operator += (const IdleStats& rhs) {
+    spin += rhs.spin;
+    yield += rhs.yield;
+    sleep += rhs.sleep;
+    num_sleeps += rhs.num_sleeps;
+    return *this;
+  }
+};
+
+/**
+@private
+*/
+class IdleCounters {
+
+  public:
+
+  using clock = std::chrono::steady_clock;
+
+  // written only by the owning worker, so a relaxed load and store suffices
+  void add_spin(clock::duration d) { _add(_spin, d.count()); }
+  void add_yield(clock::duration d) { _add(_yield, d.count()); }
+  void add_sleep(clock::duration d) {
+    _since.store(0, std::memory_order_relaxed);
+    _add(_sleep, d.count());
+    _add(_num_sleeps, 1);
+  }
+
+  // marks the start of a sleep that add_sleep will account for
+  void begin_sleep(clock::time_point t) {
+    _since.store(t.time_since_epoch().count(), std::memory_order_relaxed);
+  }
+
+  // time spent yielding and sleeping up to now, including a sleep in
+  // progress (may be slightly off while the worker is waking up)
+  clock::duration idle(clock::time_point now) const {
+    auto since = _since.load(std::memory_order_relaxed);
+    return clock::duration(
+      _yield.load(std::memory_order_relaxed) + _sleep.load(std::memory_order_relaxed)
+    ) + (since ? now - clock::time_point(clock::duration(since)) : clock::duration::zero());
+  }
+
+  IdleStats load() const {
+    IdleStats s;
+    s.spin = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock::duration(_spin.load(std::memory_order_relaxed))
+    );
+    s.yield = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock::duration(_yield.load(std::memory_order_relaxed))
+    );
+    s.sleep = std::chrono::duration_cast<std::chrono::nanoseconds>(
+      clock::duration(_sleep.load(std::memory_order_relaxed))
+    );
+    s.num_sleeps = static_cast<size_t>(_num_sleeps.load(std::memory_order_relaxed));
+    return s;
+  }
+
+  private:
+
+  std::atomic<int64_t> _spin {0};
+  std::atomic<int64_t> _yield {0};
+  std::atomic<int64_t> _sleep {0};
+  std::atomic<int64_t> _num_sleeps {0};
+  std::atomic<int64_t> _since {0};
+
+  static void _add(std::atomic<int64_t>& c, int64_t v) {
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+  }
+};
+
+}  // end of namespace tf -----------------------------------------------------
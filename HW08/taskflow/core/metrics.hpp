@@ -0,0 +1,463 @@
+#pragma once
+
+#include "task.hpp"
+
+/**
+@file metrics.hpp
+@brief metrics include file
+*/
+
+#ifndef TF_METRICS_TIMING_INTERVAL
+  /**
+  @def TF_METRICS_TIMING_INTERVAL
+
+  This macro defines how many tasks a worker runs per task whose duration
+  goes into the executor's task-duration histograms; all tasks are counted.
+  */
+  #define TF_METRICS_TIMING_INTERVAL 16
+#endif
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: WorkerMetrics
+// ----------------------------------------------------------------------------
+
+/**
+@struct WorkerMetrics
+
+@brief class to report the scheduling activity of a worker
+
+All counters are monotonic from the construction of the executor, so the
+difference of two snapshots gives the activity in between.
+*/
+struct WorkerMetrics {
+
+  /**
+  @brief number of task callables the worker ran
+  */
+  size_t num_tasks {0};
+
+  /**
+  @brief number of steals that returned a task
+  */
+  size_t num_steals {0};
+
+  /**
+  @brief number of steals that found the victim queue empty
+  */
+  size_t num_failed_steals {0};
+
+  /**
+  @brief number of tasks pushed to the executor's shared buffers because
+         the worker's queue was full
+  */
+  size_t num_overflows {0};
+
+  /**
+  @brief number of completed sleeps of the worker on the notifier
+
+  A sleep is counted when the worker wakes up, so a worker that is asleep
+  at the snapshot is not counted yet.
+  */
+  size_t num_sleeps {0};
+
+  /**
+  @brief number of sleeps after which the worker found a task before
+         sleeping again (the other sleeps ended in futile wake-ups)
+  */
+  size_t num_wakeups {0};
+
+  /**
+  @brief time spent on failed steals, i.e., the spin and yield phases of
+         tf::IdlePolicy
+  */
+  std::chrono::nanoseconds explore_time {0};
+
+  /**
+  @brief time spent sleeping on the notifier
+  */
+  std::chrono::nanoseconds sleep_time {0};
+
+  /**
+  @brief accumulates the metrics of another worker
+  */
+  WorkerMetrics& operator += (const WorkerMetrics& rhs) {
+    num_tasks += rhs.num_tasks;
+    num_steals += rhs.num_steals;
+    num_failed_steals += rhs.num_failed_steals;
+    num_overflows += rhs.num_overflows;
+    num_sleeps += rhs.num_sleeps;
+    num_wakeups += rhs.num_wakeups;
+    explore_time += rhs.explore_time;
+    sleep_time += rhs.sleep_time;
+    return *this;
+  }
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: DurationHistogram
+// ----------------------------------------------------------------------------
+
+/**
+@struct DurationHistogram
+
+@brief class to report the distribution of task durations
+
+Durations are measured with tf::read_tsc on one in
+TF_METRICS_TIMING_INTERVAL tasks of each worker and binned by powers of two of
+the counter, so bucket bounds are powers of two ticks converted to
+nanoseconds (about 0.3 ns per tick on a 3 GHz x86 machine).
+The conversion is fixed once the executor has run for 100 ms, after which
+the bounds stay the same across snapshots.
+*/
+struct DurationHistogram {
+
+  /**
+  @brief number of tasks run, timed or not
+  */
+  size_t num_tasks {0};
+
+  /**
+  @brief number of timed tasks
+  */
+  size_t count {0};
+
+  /**
+  @brief sum of the durations of the timed tasks
+  */
+  std::chrono::nanoseconds sum {0};
+
+  /**
+  @brief upper bound and number of durations of each bucket, from the
+         shortest bucket to the last non-empty one
+
+  A bucket holds the durations above the upper bound of its predecessor
+  and up to its own upper bound.
+  */
+  std::vector<std::pair<std::chrono::duration<double, std::nano>, size_t>> buckets;
+};
+
+// ----------------------------------------------------------------------------
+// Class Definition: ExecutorMetrics
+// ----------------------------------------------------------------------------
+
+/**
+@struct ExecutorMetrics
+
+@brief class to hold a snapshot of the metrics of an executor
+
+A snapshot is taken by tf::Executor::metrics without stopping the workers;
+each counter is read atomically, but counters of the same worker may be a
+few events apart.
+
+@code{.cpp}
+tf::Executor executor;
+executor.run(taskflow).wait();
+
+auto metrics = executor.metrics();
+std::cout << metrics.total().num_failed_steals << '\n';
+
+// expose the snapshot to a Prometheus scraper or a JSON consumer
+metrics.dump_prometheus(std::cout);
+metrics.dump_json(std::cout);
+@endcode
+*/
+struct ExecutorMetrics {
+
+  /**
+  @brief metrics of each worker, indexed by worker id
+  */
+  std::vector<WorkerMetrics> workers;
+
+  /**
+  @brief durations of the task callables of each tf::TaskType,
+         indexed by the value of the task type
+  */
+  std::array<DurationHistogram, TASK_TYPES.size()> task_durations;
+
+  /**
+  @brief sums the metrics of all workers
+  */
+  WorkerMetrics total() const;
+
+  /**
+  @brief dumps the snapshot in JSON through an output stream
+  */
+  void dump_json(std::ostream& os) const;
+
+  /**
+  @brief dumps the snapshot in JSON to a string
+  */
+  std::string dump_json() const;
+
+  /**
+  @brief dumps the snapshot in the Prometheus text exposition format through
+         an output stream
+
+  Worker counters are labeled by @c worker and task-duration histograms by
+  @c type; times are in seconds.
+  */
+  void dump_prometheus(std::ostream& os) const;
+
+  /**
+  @brief dumps the snapshot in the Prometheus text exposition format to a
+         string
+  */
+  std::string dump_prometheus() const;
+};
+
+// Function: total
+inline WorkerMetrics ExecutorMetrics::total() const {
+  WorkerMetrics m;
+  for(const auto& w : workers) {
+    m += w;
+  }
+  return m;
+}
+
+// Procedure: dump_json
+inline void ExecutorMetrics::dump_json(std::ostream& os) const {
+
+  os << "{\"workers\":[";
+  for(size_t i=0; i<workers.size(); ++i) {
+    const auto& w = workers[i];
+    if(i) os << ',';
+    os << "{\"id\":" << i
+       << ",\"tasks\":" << w.num_tasks
+       << ",\"steals\":" << w.num_steals
+       << ",\"failed_steals\":" << w.num_failed_steals
+       << ",\"overflows\":" << w.num_overflows
+       << ",\"sleeps\":" << w.num_sleeps
+       << ",\"wakeups\":" << w.num_wakeups
+       << ",\"explore_ns\":" << w.explore_time.count()
+       << ",\"sleep_ns\":" << w.sleep_time.count()
+       << '}';
+  }
+
+  os << "],\"task_durations\":[";
+  bool comma = false;
+  for(size_t t=0; t<task_durations.size(); ++t) {
+    const auto& h = task_durations[t];
+    if(h.num_tasks == 0) {
+      continue;
+    }
+    if(comma) os << ',';
+    comma = true;
+    os << "{\"type\":\"" << to_string(TASK_TYPES[t]) << '"'
+       << ",\"tasks\":" << h.num_tasks
+       << ",\"count\":" << h.count
+       << ",\"sum_ns\":" << h.sum.count()
+       << ",\"buckets\":[";
+    for(size_t b=0; b<h.buckets.size(); ++b) {
+      if(b) os << ',';
+      os << "{\"le_ns\":" << h.buckets[b].first.count()
+         << ",\"count\":" << h.buckets[b].second << '}';
+    }
+    os << "]}";
+  }
+  os << "]}\n";
+}
+
+// Function: dump_json
+inline std::string ExecutorMetrics::dump_json() const {
+  std::ostringstream oss;
+  dump_json(oss);
+  return oss.str();
+}
+
+// Procedure: dump_prometheus
+inline void ExecutorMetrics::dump_prometheus(std::ostream& os) const {
+
+  auto counter = [&](const char* name, const char* help, auto&& get){
+    os << "# HELP taskflow_worker_" << name << ' ' << help << '\n'
+       << "# TYPE taskflow_worker_" << name << " counter\n";
+    for(size_t i=0; i<workers.size(); ++i) {
+      os << "taskflow_worker_" << name << "{worker=\"" << i << "\"} "
+         << get(workers[i]) << '\n';
+    }
+  };
+
+  auto seconds = [](auto d){ return std::chrono::duration<double>(d).count(); };
+
+  counter("tasks_total", "Task callables run by the worker.",
+    [](auto& w){ return w.num_tasks; });
+  counter("steals_total", "Steals that returned a task.",
+    [](auto& w){ return w.num_steals; });
+  counter("failed_steals_total", "Steals that found the victim queue empty.",
+    [](auto& w){ return w.num_failed_steals; });
+  counter("overflows_total", "Tasks pushed to the shared buffers because the worker queue was full.",
+    [](auto& w){ return w.num_overflows; });
+  counter("sleeps_total", "Completed sleeps of the worker.",
+    [](auto& w){ return w.num_sleeps; });
+  counter("wakeups_total", "Sleeps after which the worker found a task.",
+    [](auto& w){ return w.num_wakeups; });
+  counter("explore_seconds_total", "Time spent on failed steals.",
+    [&](auto& w){ return seconds(w.explore_time); });
+  counter("sleep_seconds_total", "Time spent sleeping.",
+    [&](auto& w){ return seconds(w.sleep_time); });
+
+  os << "# HELP taskflow_tasks_total Task callables run, by task type.\n"
+     << "# TYPE taskflow_tasks_total counter\n";
+  for(size_t t=0; t<task_durations.size(); ++t) {
+    if(task_durations[t].num_tasks) {
+      os << "taskflow_tasks_total{type=\"" << to_string(TASK_TYPES[t]) << "\"} "
+         << task_durations[t].num_tasks << '\n';
+    }
+  }
+
+  os << "# HELP taskflow_task_duration_seconds Duration of the timed task callables.\n"
+     << "# TYPE taskflow_task_duration_seconds histogram\n";
+  for(size_t t=0; t<task_durations.size(); ++t) {
+    const auto& h = task_durations[t];
+    if(h.count == 0) {
+      continue;
+    }
+    auto type = to_string(TASK_TYPES[t]);
+    size_t cumulative = 0;
+    for(const auto& [le, n] : h.buckets) {
+      cumulative += n;
+      os << "taskflow_task_duration_seconds_bucket{type=\"" << type
+         << "\",le=\"" << seconds(le) << "\"} " << cumulative << '\n';
+    }
+    os << "taskflow_task_duration_seconds_bucket{type=\"" << type
+       << "\",le=\"+Inf\"} " << h.count << '\n'
+       << "taskflow_task_duration_seconds_sum{type=\"" << type << "\"} "
+       << seconds(h.sum) << '\n'
+       << "taskflow_task_duration_seconds_count{type=\"" << type << "\"} "
+       << h.count << '\n';
+  }
+}
+
+// Function: dump_prometheus
+inline std::string ExecutorMetrics::dump_prometheus() const {
+  std::ostringstream oss;
+  dump_prometheus(oss);
+  return oss.str();
+}
+
+// ----------------------------------------------------------------------------
+// Class Definition: MetricsCounters
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+@brief class to count the scheduling activity of a worker
+
+The counters are written only by the owning worker, with a relaxed load and
+store instead of a read-modify-write, and are padded to their own cache
+lines so that updating them never invalidates a line another worker reads.
+Every task is counted, but only one in TF_METRICS_TIMING_INTERVAL is timed,
+which keeps the two tf::read_tsc calls off most tasks.
+Defining TF_DISABLE_METRICS turns every update into a no-op.
+*/
+class alignas(TF_CACHELINE_SIZE) MetricsCounters {
+
+  public:
+
+  // bucket b > 0 holds durations in [2^(b-1), 2^b) ticks
+  constexpr static size_t NUM_BUCKETS = 48;
+
+  using Buckets = std::array<size_t, NUM_BUCKETS>;
+
+  void add_steal() { _add(_num_steals, 1); }
+  void add_failed_steals(size_t n) { _add(_num_failed_steals, n); }
+  void add_overflow() { _add(_num_overflows, 1); }
+  void add_wakeup() { _add(_num_wakeups, 1); }
+
+  // returns the start of a timed task, or zero for an untimed one
+  uint64_t begin_task() {
+#ifdef TF_DISABLE_METRICS
+    return 0;
+#else
+    if(--_countdown) {
+      return 0;
+    }
+    _countdown = TF_METRICS_TIMING_INTERVAL;
+    return read_tsc();
+#endif
+  }
+
+  void end_task([[maybe_unused]] TaskType type, [[maybe_unused]] uint64_t beg) {
+#ifndef TF_DISABLE_METRICS
+    auto t = static_cast<size_t>(type);
+    if(t >= TASK_TYPES.size()) {
+      return;
+    }
+    _add(_num_tasks[t], 1);
+    if(beg) {
+      auto ticks = read_tsc() - beg;
+      auto b = ticks ? (std::min)(floor_log2(ticks) + 1, NUM_BUCKETS - 1) : size_t{0};
+      _add(_buckets[t][b], 1);
+      _add(_ticks[t], ticks);
+    }
+#endif
+  }
+
+  // loads the counters and adds the histograms to counts and ticks
+  WorkerMetrics load(
+    std::array<size_t, TASK_TYPES.size()>& tasks,
+    std::array<Buckets, TASK_TYPES.size()>& counts,
+    std::array<uint64_t, TASK_TYPES.size()>& ticks
+  ) const {
+    WorkerMetrics m;
+    m.num_steals = _load(_num_steals);
+    m.num_failed_steals = _load(_num_failed_steals);
+    m.num_overflows = _load(_num_overflows);
+    m.num_wakeups = _load(_num_wakeups);
+    for(size_t t=0; t<TASK_TYPES.size(); ++t) {
+      auto n = _load(_num_tasks[t]);
+      tasks[t] += n;
+      m.num_tasks += n;
+      for(size_t b=0; b<NUM_BUCKETS; ++b) {
+        counts[t][b] += _load(_buckets[t][b]);
+      }
+      ticks[t] += _load(_ticks[t]);
+    }
+    return m;
+  }
+
+  static DurationHistogram histogram(
+    size_t tasks, const Buckets& counts, uint64_t ticks, double ns_per_tick
+  ) {
+    DurationHistogram h;
+    h.num_tasks = tasks;
+    h.sum = std::chrono::nanoseconds(static_cast<int64_t>(ticks * ns_per_tick));
+    size_t last = NUM_BUCKETS;
+    while(last > 0 && counts[last-1] == 0) {
+      --last;
+    }
+    for(size_t b=0; b<last; ++b) {
+      h.count += counts[b];
+      h.buckets.emplace_back(
+        std::chrono::duration<double, std::nano>(static_cast<double>(uint64_t{1} << b) * ns_per_tick),
+        counts[b]
+      );
+    }
+    return h;
+  }
+
+  private:
+
+  size_t _countdown {1};
+  std::atomic<uint64_t> _num_steals {0};
+  std::atomic<uint64_t> _num_failed_steals {0};
+  std::atomic<uint64_t> _num_overflows {0};
+  std::atomic<uint64_t> _num_wakeups {0};
+  std::array<std::atomic<uint64_t>, TASK_TYPES.size()> _num_tasks {};
+  std::array<std::atomic<uint64_t>, TASK_TYPES.size()> _ticks {};
+  std::array<std::array<std::atomic<uint64_t>, NUM_BUCKETS>, TASK_TYPES.size()> _buckets {};
+
+  static void _add([[maybe_unused]] std::atomic<uint64_t>& c, [[maybe_unused]] uint64_t v) {
+#ifndef TF_DISABLE_METRICS
+    c.store(c.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+#endif
+  }
+
+  static size_t _load(const std::atomic<uint64_t>& c) {
+    return static_cast<size_t>(c.load(std::memory_order_relaxed));
+  }
+};
+
+}  // end of namespace tf -----------------------------------------------------
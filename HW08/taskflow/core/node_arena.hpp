@@ -0,0 +1,346 @@
+#pragma once
+
+#include "graph.hpp"
+#include "worker.hpp"
+
+/**
+@file node_arena.hpp
+@brief node arena include file
+*/
+
+#ifndef TF_NODE_ARENA_BATCH_SIZE
+  /**
+  @def TF_NODE_ARENA_BATCH_SIZE
+
+  This macro defines the number of nodes a worker collects for the heap of
+  another worker before returning them to that heap in a single push.
+  */
+  #define TF_NODE_ARENA_BATCH_SIZE 32
+#endif
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// Class Definition: NodeArena
+// ----------------------------------------------------------------------------
+
+/**
+@private
+
+@brief class to allocate the nodes of async tasks from per-worker heaps
+
+An executor owns one arena with a heap per worker plus one heap shared by
+all other threads under a mutex.
+A heap carves 64 KB blocks into node slots; each block is aligned to its
+size, so a node finds its block, and through it the owning heap and arena,
+by masking its address.
+
+A worker allocates from its own free list without any synchronization.
+A freed node goes back to the heap that allocated it: directly if the
+freeing worker owns that heap, otherwise through a per-heap batch that is
+pushed onto the owner's lock-free inbox with one CAS once it holds
+TF_NODE_ARENA_BATCH_SIZE nodes or the freeing worker runs out of tasks.
+An owner whose free list runs dry takes its whole inbox before it
+allocates a new block.
+
+A node referenced by a tf::AsyncTask may be recycled after its executor
+is destroyed, in which case the arena stays alive until the last of its
+nodes is recycled.
+*/
+class NodeArena {
+
+  constexpr static size_t S = 65536;
+
+  // the executor's reference, kept far above any count of live nodes
+  constexpr static int64_t BIAS = int64_t{1} << 62;
+
+  struct Slot {
+    Slot* next;
+  };
+
+  struct Block {
+    NodeArena* arena;
+    size_t heap;
+    Block* next;
+  };
+
+  // the header is padded so that every slot keeps the alignment of a node
+  constexpr static size_t H = (sizeof(Block) + alignof(Node) - 1) / alignof(Node) * alignof(Node);
+  constexpr static size_t M = (S - H) / sizeof(Node);
+
+  static_assert(M >= 64, "block must hold at least 64 nodes");
+
+  struct Batch {
+    Slot* head {nullptr};
+    Slot* tail {nullptr};
+    size_t size {0};
+  };
+
+  struct alignas(TF_CACHELINE_SIZE) Heap {
+    // touched only by the owner (or under _mutex for the shared heap)
+    Slot* free {nullptr};
+    int64_t live {0};
+    size_t num_pending {0};
+    std::vector<Batch> batches;
+    // nodes returned by other threads
+    alignas(TF_CACHELINE_SIZE) std::atomic<Slot*> inbox {nullptr};
+  };
+
+  public:
+
+  /**
+  @brief deleter that drops the executor's reference through release
+  */
+  struct Releaser {
+    void operator () (NodeArena* arena) const { arena->release(); }
+  };
+
+  /**
+  @brief constructs an arena for the given executor and number of workers
+  */
+  NodeArena(const Executor* executor, size_t N);
+
+  /**
+  @brief releases every block of the arena
+  */
+  ~NodeArena();
+
+  /**
+  @brief allocates a node from the heap of the calling thread
+  */
+  template <typename... ArgsT>
+  Node* animate(ArgsT&&... args);
+
+  /**
+  @brief destroys a node and returns its slot to the heap that allocated it
+  */
+  static void recycle(Node* node);
+
+  /**
+  @brief returns the pending batches of worker @c w to their heaps
+  */
+  void flush(size_t w);
+
+  /**
+  @brief drops the executor's reference (called after all workers joined)
+
+  The arena deletes itself as soon as no node allocated from it is alive.
+  */
+  void release();
+
+  private:
+
+  // cleared on release so that a later executor at the same address is
+  // never taken for the owner
+  std::atomic<const Executor*> _executor;
+  const size_t _num_workers;
+
+  std::vector<Heap> _heaps;
+
+  std::mutex _mutex;
+
+  // nodes allocated minus nodes recycled by threads other than the workers,
+  // plus BIAS while the executor is alive
+  std::atomic<int64_t> _live {BIAS};
+
+  std::atomic<Block*> _blocks {nullptr};
+
+  static Block* _block_of(const void*);
+
+  size_t _this_heap() const;
+  Slot* _new_block(size_t);
+  void* _allocate(size_t);
+  void _deallocate(Slot*, size_t);
+  void _push_to_inbox(size_t, Slot*, Slot*);
+};
+
+// Constructor
+inline NodeArena::NodeArena(const Executor* executor, size_t N) :
+  _executor    {executor},
+  _num_workers {N},
+  _heaps       (N + 1) {
+  for(size_t w=0; w<N; ++w) {
+    _heaps[w].batches.resize(N + 1);
+  }
+}
+
+// Destructor
+inline NodeArena::~NodeArena() {
+  auto b = _blocks.load(std::memory_order_acquire);
+  while(b) {
+    auto next = b->next;
+    ::operator delete(static_cast<void*>(b), std::align_val_t{S});
+    b = next;
+  }
+}
+
+// Function: _block_of
+inline NodeArena::Block* NodeArena::_block_of(const void* ptr) {
+  return reinterpret_cast<Block*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t{S} - 1));
+}
+
+// Function: _this_heap
+inline size_t NodeArena::_this_heap() const {
+  auto w = pt::this_worker;
+  return (w && w->executor() == _executor.load(std::memory_order_relaxed)) ?
+         w->id() : _num_workers;
+}
+
+// Function: _new_block
+inline NodeArena::Slot* NodeArena::_new_block(size_t h) {
+
+  auto mem = static_cast<char*>(::operator new(S, std::align_val_t{S}));
+
+  auto b = ::new (mem) Block{this, h, _blocks.load(std::memory_order_relaxed)};
+  while(!_blocks.compare_exchange_weak(b->next, b, std::memory_order_release,
+                                                   std::memory_order_relaxed));
+
+  // chain the slots of the block in address order
+  Slot* head = nullptr;
+  for(size_t i=M; i-- > 0;) {
+    head = ::new (mem + H + i*sizeof(Node)) Slot{head};
+  }
+  return head;
+}
+
+// Function: _allocate
+inline void* NodeArena::_allocate(size_t h) {
+
+  auto& heap = _heaps[h];
+
+  if(h == _num_workers) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if(heap.free == nullptr) {
+      heap.free = heap.inbox.exchange(nullptr, std::memory_order_acquire);
+    }
+    if(heap.free == nullptr) {
+      heap.free = _new_block(h);
+    }
+    auto s = heap.free;
+    heap.free = s->next;
+    _live.fetch_add(1, std::memory_order_relaxed);
+    return s;
+  }
+
+  if(heap.free == nullptr) {
+    heap.free = heap.inbox.exchange(nullptr, std::memory_order_acquire);
+  }
+  if(heap.free == nullptr) {
+    heap.free = _new_block(h);
+  }
+  auto s = heap.free;
+  heap.free = s->next;
+  ++heap.live;
+  return s;
+}
+
+// Function: animate
+template <typename... ArgsT>
+Node* NodeArena::animate(ArgsT&&... args) {
+  auto h = _this_heap();
+  auto s = _allocate(h);
+  try {
+    return ::new (s) Node(std::forward<ArgsT>(args)...);
+  }
+  catch(...) {
+    _deallocate(::new (s) Slot{nullptr}, _block_of(s)->heap);
+    throw;
+  }
+}
+
+// Procedure: recycle
+inline void NodeArena::recycle(Node* node) {
+  auto b = _block_of(node);
+  node->~Node();
+  b->arena->_deallocate(::new (static_cast<void*>(node)) Slot{nullptr}, b->heap);
+}
+
+// Procedure: _push_to_inbox
+inline void NodeArena::_push_to_inbox(size_t h, Slot* head, Slot* tail) {
+  auto& inbox = _heaps[h].inbox;
+  tail->next = inbox.load(std::memory_order_relaxed);
+  while(!inbox.compare_exchange_weak(tail->next, head, std::memory_order_release,
+                                                       std::memory_order_relaxed));
+}
+
+// Procedure: _deallocate
+inline void NodeArena::_deallocate(Slot* s, size_t owner) {
+
+  auto h = _this_heap();
+
+  // not a worker of this executor: return the slot right away
+  if(h == _num_workers) {
+    _push_to_inbox(owner, s, s);
+    if(_live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+    return;
+  }
+
+  auto& heap = _heaps[h];
+  --heap.live;
+
+  if(owner == h) {
+    s->next = heap.free;
+    heap.free = s;
+    return;
+  }
+
+  auto& batch = heap.batches[owner];
+  s->next = batch.head;
+  if(batch.head == nullptr) {
+    batch.tail = s;
+  }
+  batch.head = s;
+  ++heap.num_pending;
+
+  if(++batch.size == TF_NODE_ARENA_BATCH_SIZE) {
+    _push_to_inbox(owner, batch.head, batch.tail);
+    heap.num_pending -= batch.size;
+    batch = Batch{};
+  }
+}
+
+// Procedure: flush
+inline void NodeArena::flush(size_t w) {
+  auto& heap = _heaps[w];
+  if(heap.num_pending == 0) {
+    return;
+  }
+  for(size_t h=0; h<heap.batches.size(); ++h) {
+    if(auto& batch = heap.batches[h]; batch.size) {
+      _push_to_inbox(h, batch.head, batch.tail);
+      batch = Batch{};
+    }
+  }
+  heap.num_pending = 0;
+}
+
+// Procedure: release
+inline void NodeArena::release() {
+  int64_t n = 0;
+  for(size_t w=0; w<_num_workers; ++w) {
+    n += _heaps[w].live;
+  }
+  _executor.store(nullptr, std::memory_order_relaxed);
+  if(_live.fetch_add(n - BIAS, std::memory_order_acq_rel) + n - BIAS == 0) {
+    delete this;
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Async Node Allocation
+// ----------------------------------------------------------------------------
+
+/**
+@private
+*/
+TF_FORCE_INLINE void recycle_async(Node* node) {
+#ifdef TF_DISABLE_NODE_ARENA
+  recycle(node);
+#else
+  NodeArena::recycle(node);
+#endif
+}
+
+}  // end of namespace tf -----------------------------------------------------
@@ -174,15 +174,13 @@ class NonblockingNotifierV1 {
     _notify<true>();
   }
 
-  // notify n workers
+  // notify n workers, stopping early once no worker is left to wake
   void notify_n(size_t n) {
     if(n >= _waiters.size()) {
       _notify<true>();
     }
     else {
-      for(size_t k=0; k<n; ++k) {
-        _notify<false>();
-      }
+      for(size_t k=0; k<n && _notify<false>(); ++k);
     }
   }
 
@@ -254,14 +252,15 @@ class NonblockingNotifierV1 {
   
   // notify wakes one or all waiting threads.
   // Must be called after changing the associated wait predicate.
+  // Returns false if there was no thread to wake.
   template <bool all>
-  void _notify() {
+  bool _notify() {
     std::atomic_thread_fence(std::memory_order_seq_cst);
     uint64_t state = _state.load(std::memory_order_acquire);
     for (;;) {
       // Easy case: no waiters.
       if ((state & kStackMask) == kStackMask && (state & kWaiterMask) == 0) {
-        return;
+        return false;
       }
       uint64_t waiters = (state & kWaiterMask) >> kWaiterShift;
       uint64_t newstate;
@@ -288,14 +287,14 @@ class NonblockingNotifierV1 {
       }
       if (_state.compare_exchange_weak(state, newstate,
                                        std::memory_order_acquire)) {
-        if (!all && waiters) return;  // unblocked pre-wait thread
-        if ((state & kStackMask) == kStackMask) return;
+        if (!all && waiters) return true;  // unblocked pre-wait thread
+        if ((state & kStackMask) == kStackMask) return true;
         Waiter* w = &_waiters[state & kStackMask];
         if (!all) {
           w->next.store(nullptr, std::memory_order_relaxed);
         }
         _unpark(w);
-        return;
+        return true;
       }
     }
   }
@@ -435,15 +434,13 @@ class NonblockingNotifierV2 {
     _notify<true>();
   }
   
-  // notify n workers
+  // notify n workers, stopping early once no worker is left to wake
   void notify_n(size_t n) {
     if(n >= _waiters.size()) {
       _notify<true>();
     }
     else {
-      for(size_t k=0; k<n; ++k) {
-        _notify<false>();
-      }
+      for(size_t k=0; k<n && _notify<false>(); ++k);
     }
   }
 
@@ -498,8 +495,9 @@ class NonblockingNotifierV2 {
   
   // Notify wakes one or all waiting threads.
   // Must be called after changing the associated wait predicate.
+  // Returns false if there was no thread to wake.
   template <bool notifyAll>
-  void _notify() {
+  bool _notify() {
     std::atomic_thread_fence(std::memory_order_seq_cst);
     uint64_t state = _state.load(std::memory_order_acquire);
     for (;;) {
@@ -507,7 +505,7 @@ class NonblockingNotifierV2 {
       const uint64_t waiters = (state & kWaiterMask) >> kWaiterShift;
       const uint64_t signals = (state & kSignalMask) >> kSignalShift;
       // Easy case: no waiters.
-      if ((state & kStackMask) == kStackMask && waiters == signals) return;
+      if ((state & kStackMask) == kStackMask && waiters == signals) return false;
       uint64_t newstate;
       if (notifyAll) {
         // Empty wait stack and set signal to number of pre-wait threads.
@@ -523,12 +521,12 @@ class NonblockingNotifierV2 {
       }
       //_check_state(newstate);
       if (_state.compare_exchange_weak(state, newstate, std::memory_order_acq_rel)) {
-        if (!notifyAll && (signals < waiters)) return;  // unblocked pre-wait thread
-        if ((state & kStackMask) == kStackMask) return;
+        if (!notifyAll && (signals < waiters)) return true;  // unblocked pre-wait thread
+        if ((state & kStackMask) == kStackMask) return true;
         Waiter* w = &_waiters[state & kStackMask];
         if (!notifyAll) w->next.store(kStackMask, std::memory_order_relaxed);
         _unpark(w);
-        return;
+        return true;
       }
     }
   }
@@ -442,6 +442,8 @@ class TFProfObserver : public ObserverInterface {
 
   friend class Executor;
   friend class TFProfManager;
+  friend class TFStreamObserver;
+  friend class CriticalPathAnalyzer;
 
   /** @private overall task summary */
   struct TaskSummary {
@@ -920,6 +922,627 @@ inline size_t TFProfObserver::num_workers() const {
 }
 
 
+// ----------------------------------------------------------------------------
+// TFStreamObserver definition
+// ----------------------------------------------------------------------------
+
+/**
+@class TFStreamObserver
+
+@brief class to create an observer that streams sampled task records to a
+       file with bounded memory
+
+A tf::TFProfObserver keeps every segment in memory until it is dumped, so
+its footprint grows with the length of the run.
+A tf::TFStreamObserver instead gives each worker a lock-free ring of
+@c capacity fixed-size records, which only that worker writes.
+A background thread drains all rings every @c period, or as soon as a ring
+passes half full, and appends them to a @c .tfp stream file as compressed
+chunks, so the memory of the observer is fixed and a run that crashes
+still leaves every chunk drained before the crash.
+A worker that finds its ring full drops the record instead of waiting, and
+the number of dropped records is written to the file too.
+
+To keep the cost per task low, timestamps come from tf::read_tsc instead of
+@c std::chrono, and a worker records only every @c sampling-th task it runs;
+an unsampled task costs a decrement and a push onto a small stack.
+
+Drops happen when a worker records faster than the drainer encodes: the
+half-full wakeup hides the drain period, but a ring of @c capacity records
+must still absorb what a worker produces while the drainer encodes all
+rings once.
+The default capacity covers two periods at one task per microsecond per
+worker; for finer tasks or a busier machine, where the drainer may not
+get a core in time, record every n-th task (@c sampling) or pass a larger
+@c capacity.
+
+@code{.cpp}
+tf::Taskflow taskflow;
+tf::Executor executor;
+
+// insert tasks into taskflow
+// ...
+
+// record every 16th task of each worker into run.tfp
+auto observer = executor.make_observer<tf::TFStreamObserver>("run.tfp", 16);
+
+// run the taskflow
+executor.run(taskflow).wait();
+
+// write the records still in the rings
+observer->flush();
+
+// records dropped because a ring filled up before the drainer emptied it;
+// if this is not zero, raise the capacity or the sampling interval
+std::cout << observer->num_dropped() << " records dropped\n";
+
+// decode the file into a tf::TFProfObserver, e.g., for a summary report
+std::ifstream ifs("run.tfp", std::ios::binary);
+tf::TFProfObserver profile = tf::TFStreamObserver::load(ifs);
+profile.summary(std::cout);
+@endcode
+
+Setting the environment variable @c TF_ENABLE_STREAM_PROFILER to a file
+path makes every executor stream its tasks to that file (the n-th executor
+created after the first writes to <tt>path.n</tt>), with the sampling
+interval taken from @c TF_PROFILER_SAMPLING (default 1).
+
+A stream file starts with the magic @c TFSTREAM followed by the executor
+id, the number of workers, the sampling interval and a pair of TSC and
+@c steady_clock readings.
+The rest is a sequence of chunks, each a kind byte and a varint length
+followed by the payload: task names, per-worker records, drop counts and
+a new clock pair after every drain.
+Records are delta- and varint-encoded, which shrinks the 24-byte records
+of the rings to about 6 bytes for fine-grained tasks.
+*/
+class TFStreamObserver : public ObserverInterface {
+
+  friend class Executor;
+
+  constexpr static uint64_t UNSAMPLED = ~uint64_t{0};
+
+  // fixed-size record written by a worker
+  struct Record {
+    uint64_t beg;
+    uint64_t end;
+    uint32_t name;
+    uint16_t level;
+    uint8_t type;
+  };
+
+  struct alignas(TF_CACHELINE_SIZE) Ring {
+    // touched only by the owning worker
+    std::vector<Record> records;
+    std::vector<uint64_t> stack;
+    std::unordered_map<std::string, uint32_t> names;
+    size_t countdown {1};
+    size_t cached_head {0};
+    size_t next_wake {0};
+    // written by the owning worker, read by the drainer
+    std::atomic<size_t> tail {0};
+    std::atomic<size_t> dropped {0};
+    // written by the drainer
+    alignas(TF_CACHELINE_SIZE) std::atomic<size_t> head {0};
+    size_t reported {0};
+  };
+
+  public:
+
+    /**
+    @brief constructs a stream observer
+
+    @param path the stream file to create
+    @param sampling records every @c sampling-th task of each worker
+    @param capacity number of records in each worker's ring
+                    (rounded up to a power of two); zero sizes it from
+                    @c period, see below
+    @param period interval at which the rings are drained to the file
+
+    With the default @c capacity of zero, each ring holds two periods of
+    records at one task per microsecond per worker, divided by
+    @c sampling, and at least 4096 records (e.g., 32768 records, or
+    768 KB, for a period of 10 ms and a sampling of one).
+
+    The constructor throws if the file cannot be created.
+    */
+    TFStreamObserver(
+      const std::string& path,
+      size_t sampling = 1,
+      size_t capacity = 0,
+      std::chrono::milliseconds period = std::chrono::milliseconds(10)
+    );
+
+    /**
+    @brief stops the drainer and writes the remaining records to the file
+    */
+    ~TFStreamObserver();
+
+    /**
+    @brief writes the records currently in the rings to the file
+    */
+    void flush();
+
+    /**
+    @brief queries the number of records written to the file
+    */
+    size_t num_records() const;
+
+    /**
+    @brief queries the number of records dropped because a ring was full
+    */
+    size_t num_dropped() const;
+
+    /**
+    @brief decodes a stream file into a tf::TFProfObserver
+
+    The returned observer holds the recorded segments, so tf::TFProfObserver::dump
+    and tf::TFProfObserver::summary work on a streamed profile.
+    Decoding stops at the first truncated chunk.
+    */
+    static TFProfObserver load(std::istream& is);
+
+  private:
+
+    std::ofstream _ofs;
+
+    const size_t _sampling;
+    const size_t _capacity;
+    const std::chrono::milliseconds _period;
+
+    std::vector<Ring> _rings;
+
+    std::mutex _names_mutex;
+    std::unordered_map<std::string, uint32_t> _name_ids;
+    std::vector<const std::string*> _names;
+    size_t _num_written_names {0};
+
+    // serializes drains between the drainer and flush
+    std::mutex _drain_mutex;
+    std::string _chunk;
+    std::atomic<size_t> _num_records {0};
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    bool _stop {false};
+    std::atomic<bool> _wake {false};
+    std::thread _drainer;
+
+    inline void set_up(size_t num_workers) override final;
+    inline void on_entry(WorkerView, TaskView) override final;
+    inline void on_exit(WorkerView, TaskView) override final;
+
+    uint32_t _name_id(Ring&, const std::string&);
+    void _wake_drainer();
+    void _drain();
+    void _write_chunk(char, const std::string&);
+
+    static std::string _env_path();
+    static size_t _env_sampling();
+
+    static void _put_varint(std::string&, uint64_t);
+    static bool _get_varint(const char*&, const char*, uint64_t&);
+    static void _put_clock(std::string&);
+};
+
+// Constructor
+inline TFStreamObserver::TFStreamObserver(
+  const std::string& path,
+  size_t sampling,
+  size_t capacity,
+  std::chrono::milliseconds period
+) :
+  _ofs      (path, std::ios::binary | std::ios::trunc),
+  _sampling {sampling},
+  _capacity {next_pow2((std::max)(
+    capacity ? capacity : (std::max)(
+      static_cast<size_t>(2 * std::chrono::microseconds(period).count()) / (std::max)(sampling, size_t{1}),
+      size_t{4096}
+    ),
+    size_t{2}
+  ))},
+  _period   {period} {
+
+  if(!_ofs) {
+    TF_THROW("failed to create stream profile ", path);
+  }
+  if(sampling == 0) {
+    TF_THROW("stream observer sampling must be at least one");
+  }
+}
+
+// Destructor
+inline TFStreamObserver::~TFStreamObserver() {
+  if(_drainer.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stop = true;
+    }
+    _cv.notify_one();
+    _drainer.join();
+  }
+  _drain();
+}
+
+// Procedure: set_up
+inline void TFStreamObserver::set_up(size_t num_workers) {
+
+  _rings = std::vector<Ring>(num_workers);
+  for(auto& r : _rings) {
+    r.records.resize(_capacity);
+    r.stack.reserve(32);
+    r.next_wake = _capacity / 2;
+  }
+
+  std::string header("TFSTREAM");
+  _put_varint(header, unique_id<size_t>());
+  _put_varint(header, num_workers);
+  _put_varint(header, _sampling);
+  _put_clock(header);
+  _ofs.write(header.data(), header.size());
+
+  _drainer = std::thread([this](){
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(!_stop) {
+      _cv.wait_for(lock, _period, [this](){
+        return _stop || _wake.load(std::memory_order_relaxed);
+      });
+      _wake.store(false, std::memory_order_relaxed);
+      lock.unlock();
+      _drain();
+      lock.lock();
+    }
+  });
+}
+
+// Procedure: on_entry
+inline void TFStreamObserver::on_entry(WorkerView wv, TaskView) {
+  auto& r = _rings[wv.id()];
+  if(--r.countdown == 0) {
+    r.countdown = _sampling;
+    r.stack.push_back(read_tsc());
+  }
+  else {
+    r.stack.push_back(UNSAMPLED);
+  }
+}
+
+// Procedure: on_exit
+inline void TFStreamObserver::on_exit(WorkerView wv, TaskView tv) {
+
+  auto& r = _rings[wv.id()];
+
+  assert(!r.stack.empty());
+
+  auto beg = r.stack.back();
+  r.stack.pop_back();
+
+  if(beg == UNSAMPLED) {
+    return;
+  }
+
+  auto end = read_tsc();
+  auto t = r.tail.load(std::memory_order_relaxed);
+
+  if(t - r.cached_head == _capacity) {
+    r.cached_head = r.head.load(std::memory_order_acquire);
+    if(t - r.cached_head == _capacity) {
+      r.dropped.store(r.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      _wake_drainer();
+      return;
+    }
+  }
+
+  r.records[t & (_capacity - 1)] = Record{
+    beg, end, _name_id(r, tv.name()),
+    static_cast<uint16_t>(r.stack.size()), static_cast<uint8_t>(tv.type())
+  };
+  r.tail.store(++t, std::memory_order_release);
+
+  // wake the drainer when the ring reaches half full rather than waiting
+  // for the period; next_wake is the earliest tail at which that can
+  // happen, and while the drainer lags behind we check again every
+  // quarter ring until the full check above takes over
+  if(t >= r.next_wake) {
+    r.cached_head = r.head.load(std::memory_order_acquire);
+    if(t - r.cached_head >= _capacity / 2) {
+      _wake_drainer();
+      r.next_wake = t + (std::max)(_capacity / 4, size_t{1});
+    }
+    else {
+      r.next_wake = r.cached_head + _capacity / 2;
+    }
+  }
+}
+
+// Procedure: _wake_drainer
+inline void TFStreamObserver::_wake_drainer() {
+  // the lock keeps the wakeup from being lost between the drainer's
+  // predicate check and its wait
+  if(!_wake.load(std::memory_order_relaxed) &&
+     !_wake.exchange(true, std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cv.notify_one();
+  }
+}
+
+// Function: _name_id
+inline uint32_t TFStreamObserver::_name_id(Ring& r, const std::string& name) {
+
+  if(name.empty()) {
+    return 0;
+  }
+
+  if(auto itr = r.names.find(name); itr != r.names.end()) {
+    return itr->second;
+  }
+
+  std::lock_guard<std::mutex> lock(_names_mutex);
+  auto [itr, inserted] = _name_ids.try_emplace(name, static_cast<uint32_t>(_names.size() + 1));
+  if(inserted) {
+    _names.push_back(&itr->first);
+  }
+  r.names.emplace(name, itr->second);
+  return itr->second;
+}
+
+// Procedure: flush
+inline void TFStreamObserver::flush() {
+  _drain();
+}
+
+// Procedure: _drain
+inline void TFStreamObserver::_drain() {
+
+  std::lock_guard<std::mutex> lock(_drain_mutex);
+
+  // read the tails before the names so that every name a record refers to
+  // is written ahead of the record
+  std::vector<size_t> tails(_rings.size());
+  for(size_t w=0; w<_rings.size(); ++w) {
+    tails[w] = _rings[w].tail.load(std::memory_order_acquire);
+  }
+
+  {
+    std::lock_guard<std::mutex> names_lock(_names_mutex);
+    if(_num_written_names < _names.size()) {
+      _chunk.clear();
+      _put_varint(_chunk, _num_written_names + 1);
+      _put_varint(_chunk, _names.size() - _num_written_names);
+      for(; _num_written_names < _names.size(); ++_num_written_names) {
+        auto& name = *_names[_num_written_names];
+        _put_varint(_chunk, name.size());
+        _chunk.append(name);
+      }
+      _write_chunk('N', _chunk);
+    }
+  }
+
+  for(size_t w=0; w<_rings.size(); ++w) {
+
+    auto& r = _rings[w];
+    auto h = r.head.load(std::memory_order_relaxed);
+
+    if(auto n = tails[w] - h; n) {
+      _chunk.clear();
+      _put_varint(_chunk, w);
+      _put_varint(_chunk, n);
+      uint64_t prev = 0;
+      for(; h != tails[w]; ++h) {
+        auto& rec = r.records[h & (_capacity - 1)];
+        // nested tasks exit before their parents, so begin times may go back
+        int64_t d = static_cast<int64_t>(rec.beg - prev);
+        _put_varint(_chunk, (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63));
+        _put_varint(_chunk, rec.end - rec.beg);
+        _put_varint(_chunk, rec.name);
+        _put_varint(_chunk, (uint64_t{rec.level} << 3) | rec.type);
+        prev = rec.beg;
+      }
+      r.head.store(h, std::memory_order_release);
+      _write_chunk('R', _chunk);
+      _num_records.fetch_add(n, std::memory_order_relaxed);
+    }
+
+    if(auto d = r.dropped.load(std::memory_order_relaxed); d != r.reported) {
+      _chunk.clear();
+      _put_varint(_chunk, w);
+      _put_varint(_chunk, d);
+      _write_chunk('D', _chunk);
+      r.reported = d;
+    }
+  }
+
+  _chunk.clear();
+  _put_clock(_chunk);
+  _write_chunk('C', _chunk);
+
+  _ofs.flush();
+}
+
+// Procedure: _write_chunk
+inline void TFStreamObserver::_write_chunk(char kind, const std::string& payload) {
+  std::string prefix(1, kind);
+  _put_varint(prefix, payload.size());
+  _ofs.write(prefix.data(), prefix.size());
+  _ofs.write(payload.data(), payload.size());
+}
+
+// Function: num_records
+inline size_t TFStreamObserver::num_records() const {
+  return _num_records.load(std::memory_order_relaxed);
+}
+
+// Function: num_dropped
+inline size_t TFStreamObserver::num_dropped() const {
+  size_t n = 0;
+  for(auto& r : _rings) {
+    n += r.dropped.load(std::memory_order_relaxed);
+  }
+  return n;
+}
+
+// Procedure: _put_varint
+inline void TFStreamObserver::_put_varint(std::string& s, uint64_t v) {
+  while(v >= 0x80) {
+    s.push_back(static_cast<char>(v | 0x80));
+    v >>= 7;
+  }
+  s.push_back(static_cast<char>(v));
+}
+
+// Function: _get_varint
+inline bool TFStreamObserver::_get_varint(const char*& p, const char* e, uint64_t& v) {
+  v = 0;
+  for(int shift = 0; p != e && shift < 64; shift += 7) {
+    auto b = static_cast<uint8_t>(*p++);
+    v |= uint64_t{b & 0x7fu} << shift;
+    if((b & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Procedure: _put_clock
+inline void TFStreamObserver::_put_clock(std::string& s) {
+  auto tsc = read_tsc();
+  auto now = observer_stamp_t::clock::now();
+  _put_varint(s, tsc);
+  _put_varint(s, static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count()
+  ));
+}
+
+// Function: _env_path
+inline std::string TFStreamObserver::_env_path() {
+  static std::atomic<size_t> count {0};
+  auto path = get_env(TF_ENABLE_STREAM_PROFILER);
+  if(auto n = count.fetch_add(1, std::memory_order_relaxed); n) {
+    path += '.' + std::to_string(n);
+  }
+  return path;
+}
+
+// Function: _env_sampling
+inline size_t TFStreamObserver::_env_sampling() {
+  auto s = get_env(TF_PROFILER_SAMPLING);
+  return s.empty() ? 1 : (std::max)(std::strtoull(s.c_str(), nullptr, 10), 1ull);
+}
+
+// Function: load
+inline TFProfObserver TFStreamObserver::load(std::istream& is) {
+
+  using namespace std::chrono;
+
+  TFProfObserver observer;
+
+  std::string data(std::istreambuf_iterator<char>(is), {});
+  const char* p = data.data();
+  const char* e = p + data.size();
+
+  if(data.compare(0, 8, "TFSTREAM") != 0) {
+    TF_THROW("not a stream profile");
+  }
+  p += 8;
+
+  uint64_t uid, num_workers, sampling, tsc0, ns0;
+  if(!_get_varint(p, e, uid) || !_get_varint(p, e, num_workers) ||
+     !_get_varint(p, e, sampling) || !_get_varint(p, e, tsc0) ||
+     !_get_varint(p, e, ns0)) {
+    TF_THROW("truncated stream profile header");
+  }
+
+  struct Raw {
+    uint64_t worker, beg, end, name, level, type;
+  };
+
+  std::vector<Raw> raws;
+  std::vector<std::string> names(1);
+  uint64_t tsc1 = tsc0, ns1 = ns0;
+
+  while(p != e) {
+
+    char kind = *p++;
+    uint64_t size;
+    if(!_get_varint(p, e, size) || static_cast<uint64_t>(e - p) < size) {
+      break;
+    }
+
+    const char* q = p;
+    const char* qe = p + size;
+    p = qe;
+
+    uint64_t a, n;
+    switch(kind) {
+      case 'N':
+        if(!_get_varint(q, qe, a) || !_get_varint(q, qe, n)) break;
+        names.resize(a);
+        while(n--) {
+          uint64_t len;
+          if(!_get_varint(q, qe, len) || static_cast<uint64_t>(qe - q) < len) break;
+          names.emplace_back(q, len);
+          q += len;
+        }
+      break;
+
+      case 'R': {
+        if(!_get_varint(q, qe, a) || !_get_varint(q, qe, n)) break;
+        uint64_t beg = 0;
+        while(n--) {
+          uint64_t d, span, name, lt;
+          if(!_get_varint(q, qe, d) || !_get_varint(q, qe, span) ||
+             !_get_varint(q, qe, name) || !_get_varint(q, qe, lt)) break;
+          beg += (d >> 1) ^ (~(d & 1) + 1);
+          raws.push_back({a, beg, beg + span, name, lt >> 3, lt & 7});
+        }
+      }
+      break;
+
+      case 'C':
+        if(_get_varint(q, qe, a) && _get_varint(q, qe, n)) {
+          tsc1 = a;
+          ns1 = n;
+        }
+      break;
+
+      // drop counts and unknown chunks carry no segments
+      default:
+      break;
+    }
+  }
+
+  // convert ticks to nanoseconds with the widest clock pair in the file
+  double ns_per_tick = (tsc1 > tsc0) ? double(ns1 - ns0) / double(tsc1 - tsc0) : 1.0;
+  auto to_stamp = [&](uint64_t tsc){
+    return observer_stamp_t(duration_cast<observer_stamp_t::duration>(nanoseconds(
+      static_cast<int64_t>(ns0) +
+      static_cast<int64_t>(static_cast<double>(static_cast<int64_t>(tsc - tsc0)) * ns_per_tick)
+    )));
+  };
+
+  auto& tl = observer._timeline;
+  tl.uid = uid;
+  tl.origin = observer_stamp_t(duration_cast<observer_stamp_t::duration>(nanoseconds(ns0)));
+  tl.segments.resize(num_workers);
+  observer._stacks.resize(num_workers);
+
+  for(auto& r : raws) {
+    if(r.worker >= num_workers || r.type >= TASK_TYPES.size()) {
+      continue;
+    }
+    auto& levels = tl.segments[r.worker];
+    if(levels.size() <= r.level) {
+      levels.resize(r.level + 1);
+    }
+    levels[r.level].emplace_back(
+      r.name < names.size() ? names[r.name] : std::string(),
+      TASK_TYPES[r.type], to_stamp(r.beg), to_stamp(r.end)
+    );
+  }
+
+  return observer;
+}
+
 // ----------------------------------------------------------------------------
 // TFProfManager
 // ----------------------------------------------------------------------------
@@ -479,18 +479,18 @@ inline bool Executor::_invoke_runtime_task(Worker& worker, Node* node) {
 
 // Function: _invoke_runtime_task_impl
 inline bool Executor::_invoke_runtime_task_impl(
-  Worker& worker, Node* node, std::function<void(Runtime&)>& work
+  Worker& worker, Node* node, SmallFunction<void(Runtime&)>& work
 ) {
   // first time
   if((node->_nstate & NSTATE::PREEMPTED) == 0) {
 
     Runtime rt(*this, worker, node);
 
-    _observer_prologue(worker, node);
+    auto beg = _observer_prologue(worker, node);
     TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
       work(rt);
     });
-    _observer_epilogue(worker, node);
+    _observer_epilogue(worker, node, beg);
     
     // here, we cannot check the state from node->_nstate due to data race
     if(rt._preempted) {
@@ -506,7 +506,7 @@ inline bool Executor::_invoke_runtime_task_impl(
 
 // Function: _invoke_runtime_task_impl
 inline bool Executor::_invoke_runtime_task_impl(
-  Worker& worker, Node* node, std::function<void(Runtime&, bool)>& work
+  Worker& worker, Node* node, SmallFunction<void(Runtime&, bool)>& work
 ) {
     
   Runtime rt(*this, worker, node);
@@ -514,11 +514,11 @@ inline bool Executor::_invoke_runtime_task_impl(
   // first time
   if((node->_nstate & NSTATE::PREEMPTED) == 0) {
 
-    _observer_prologue(worker, node);
+    auto beg = _observer_prologue(worker, node);
     TF_EXECUTOR_EXCEPTION_HANDLER(worker, node, {
       work(rt, false);
     });
-    _observer_epilogue(worker, node);
+    _observer_epilogue(worker, node, beg);
     
     // here, we cannot check the state from node->_nstate due to data race
     // Ex: if preempted, another task may finish real quck and insert this parent task
@@ -371,6 +371,36 @@ class Task {
     @return @c *this
     */
     Task& data(void* data);
+
+    /**
+    @brief assigns a priority value to the task
+
+    A priority value can be one of the following three levels,
+      + tf::TaskPriority::HIGH (numerically equivalent to 0)
+      + tf::TaskPriority::NORMAL (numerically equivalent to 1)
+      + tf::TaskPriority::LOW (numerically equivalent to 2)
+
+    When a task becomes ready, it goes to the lane of its priority in the
+    worker's queue (or in the executor's shared buffers), and workers pop and
+    steal from the highest-priority non-empty lane first.
+    Lower lanes are still served periodically
+    (see TF_TASK_PRIORITY_AGING), so they cannot starve.
+    Priorities order ready tasks only; they do not preempt running tasks
+    or change the dependencies of the graph.
+    The default priority is tf::TaskPriority::NORMAL.
+
+    @code{.cpp}
+    auto urgent = taskflow.emplace([](){}).priority(tf::TaskPriority::HIGH);
+    @endcode
+
+    @return @c *this
+    */
+    Task& priority(TaskPriority p);
+
+    /**
+    @brief queries the priority value of the task
+    */
+    TaskPriority priority() const;
     
     /**
     @brief resets the task handle to null
@@ -487,54 +517,46 @@ inline bool Task::operator != (const Task& rhs) const {
 
 // Function: name
 inline Task& Task::name(const std::string& name) {
-  _node->_name = name;
+  _node->_cold_data().name = name;
   return *this;
 }
 
 // Function: acquire
 inline Task& Task::acquire(Semaphore& s) {
-  if(!_node->_semaphores) {
-    _node->_semaphores = std::make_unique<Node::Semaphores>();
-  }
-  _node->_semaphores->to_acquire.push_back(&s);
+  auto& semaphores = _node->_cold_data().semaphores;
+  semaphores.to_acquire.push_back(&s);
   return *this;
 }
 
 // Function: acquire
 template <typename I>
 Task& Task::acquire(I first, I last) {
-  if(!_node->_semaphores) {
-    _node->_semaphores = std::make_unique<Node::Semaphores>();
-  }
-  _node->_semaphores->to_acquire.reserve(
-    _node->_semaphores->to_acquire.size() + std::distance(first, last)
+  auto& semaphores = _node->_cold_data().semaphores;
+  semaphores.to_acquire.reserve(
+    semaphores.to_acquire.size() + std::distance(first, last)
   );
   for(auto s = first; s != last; ++s){
-    _node->_semaphores->to_acquire.push_back(&(*s));
+    semaphores.to_acquire.push_back(&(*s));
   }
   return *this;
 }
 
 // Function: release
 inline Task& Task::release(Semaphore& s) {
-  if(!_node->_semaphores) {
-    _node->_semaphores = std::make_unique<Node::Semaphores>();
-  }
-  _node->_semaphores->to_release.push_back(&s);
+  auto& semaphores = _node->_cold_data().semaphores;
+  semaphores.to_release.push_back(&s);
   return *this;
 }
 
 // Function: release
 template <typename I>
 Task& Task::release(I first, I last) {
-  if(!_node->_semaphores) {
-    _node->_semaphores = std::make_unique<Node::Semaphores>();
-  }
-  _node->_semaphores->to_release.reserve(
-    _node->_semaphores->to_release.size() + std::distance(first, last)
+  auto& semaphores = _node->_cold_data().semaphores;
+  semaphores.to_release.reserve(
+    semaphores.to_release.size() + std::distance(first, last)
   );
   for(auto s = first; s != last; ++s) {
-    _node->_semaphores->to_release.push_back(&(*s));
+    semaphores.to_release.push_back(&(*s));
   }
   return *this;
 }
@@ -551,7 +573,7 @@ inline void Task::reset_work() {
 
 // Function: name
 inline const std::string& Task::name() const {
-  return _node->_name;
+  return _node->name();
 }
 
 // Function: num_predecessors
@@ -656,15 +678,26 @@ Task& Task::work(C&& c) {
 
 // Function: data
 inline void* Task::data() const {
-  return _node->_data;
+  return _node->_cold ? _node->_cold->data : nullptr;
 }
 
 // Function: data
 inline Task& Task::data(void* data) {
-  _node->_data = data;
+  _node->_cold_data().data = data;
   return *this;
 }
 
+// Function: priority
+inline Task& Task::priority(TaskPriority p) {
+  _node->_priority = p;
+  return *this;
+}
+
+// Function: priority
+inline TaskPriority Task::priority() const {
+  return _node->_priority;
+}
+
 // ----------------------------------------------------------------------------
 // global ostream
 // ----------------------------------------------------------------------------
@@ -697,6 +730,11 @@ class TaskView {
     */
     const std::string& name() const;
 
+    /**
+    @brief queries the priority of the task
+    */
+    TaskPriority priority() const;
+
     /**
     @brief queries the number of successors of the task
     */
@@ -753,7 +791,12 @@ inline TaskView::TaskView(const Node& node) : _node {node} {
 
 // Function: name
 inline const std::string& TaskView::name() const {
-  return _node._name;
+  return _node.name();
+}
+
+// Function: priority
+inline TaskPriority TaskView::priority() const {
+  return _node._priority;
 }
 
 // Function: num_predecessors
@@ -438,8 +438,8 @@ inline void Taskflow::_dump(
 
   // label of the node
   os << 'p' << node << "[label=\"";
-  if(node->_name.empty()) os << 'p' << node;
-  else os << node->_name;
+  if(node->name().empty()) os << 'p' << node;
+  else os << node->name();
   os << "\" ";
 
   // shape of the node
@@ -480,8 +480,8 @@ inline void Taskflow::_dump(
       auto& sbg = std::get_if<Node::Subflow>(&node->_handle)->subgraph;
       if(!sbg.empty()) {
         os << "subgraph cluster_p" << node << " {\nlabel=\"Subflow: ";
-        if(node->_name.empty()) os << 'p' << node;
-        else os << node->_name;
+        if(node->name().empty()) os << 'p' << node;
+        else os << node->name();
 
         os << "\";\n" << "color=blue\n";
         _dump(os, &sbg, dumper);
@@ -514,8 +514,8 @@ inline void Taskflow::_dump(
       auto module = &(std::get_if<Node::Module>(&n->_handle)->graph);
 
       os << 'p' << n << "[shape=box3d, color=blue, label=\"";
-      if(n->_name.empty()) os << 'p' << n;
-      else os << n->_name;
+      if(n->name().empty()) os << 'p' << n;
+      else os << n->name();
 
       if(dumper.visited.find(module) == dumper.visited.end()) {
         dumper.visited[module] = dumper.id++;
@@ -28,8 +28,44 @@
   #define TF_DEFAULT_UNBOUNDED_TASK_QUEUE_LOG_SIZE 10
 #endif
 
+#ifndef TF_TASK_PRIORITY_AGING
+  /**
+  @def TF_TASK_PRIORITY_AGING
+
+  This macro defines how often a prioritized task queue serves its lowest
+  non-empty lane first: one in every TF_TASK_PRIORITY_AGING pops (or aged
+  steals) scans the lanes from the lowest priority up, so lower-priority
+  tasks cannot starve under a steady stream of higher-priority ones.
+  */
+  #define TF_TASK_PRIORITY_AGING 16
+#endif
+
 namespace tf {
 
+// ----------------------------------------------------------------------------
+// Task Priority
+// ----------------------------------------------------------------------------
+
+/**
+@enum TaskPriority
+
+@brief enumerates the task priority
+
+Each priority has its own lane in the queue of every worker and in the
+executor's shared buffers.
+Workers pop and steal from the lane of the highest priority first.
+*/
+enum class TaskPriority : unsigned {
+  /** @brief value of the highest priority (i.e., 0) */
+  HIGH = 0,
+  /** @brief value of the normal priority (i.e., 1), the default */
+  NORMAL = 1,
+  /** @brief value of the lowest priority (i.e., 2) */
+  LOW = 2,
+  /** @brief conventional value for iterating priority values */
+  MAX = 3
+};
+
 // ----------------------------------------------------------------------------
 // Task Queue
 // ----------------------------------------------------------------------------
@@ -139,6 +175,21 @@ class UnboundedTaskQueue {
   */
   void push(T item);
 
+  /**
+  @brief inserts a batch of items to the queue
+
+  @tparam I input iterator type whose value is convertible to @c T
+  @param first iterator to the first item
+  @param N number of items to insert
+
+  Only the owner thread can insert items to the queue.
+  The queue grows at most once to fit all @c N items, and the items become
+  visible to thieves together through a single store to the bottom index.
+  The iterator is not touched after that store.
+  */
+  template <typename I>
+  void bulk_push(I first, size_t N);
+
   /**
   @brief pops out an item from the queue
 
@@ -227,6 +278,43 @@ void UnboundedTaskQueue<T>::push(T o) {
   _bottom.store(b + 1, std::memory_order_release);
 }
 
+// Function: bulk_push
+template <typename T>
+template <typename I>
+void UnboundedTaskQueue<T>::bulk_push(I first, size_t N) {
+
+  if(N == 0) {
+    return;
+  }
+
+  int64_t b = _bottom.load(std::memory_order_relaxed);
+  int64_t t = _top.load(std::memory_order_acquire);
+  Array* a = _array.load(std::memory_order_relaxed);
+
+  // grow until the batch fits with one additional item
+  if TF_UNLIKELY(a->capacity() - 1 < (b - t) + static_cast<int64_t>(N) - 1) {
+    Array* tmp = a;
+    while(tmp->capacity() - 1 < (b - t) + static_cast<int64_t>(N) - 1) {
+      Array* bigger = tmp->resize(b, t);
+      if(tmp != a) {
+        delete tmp;
+      }
+      tmp = bigger;
+    }
+    _garbage.push_back(a);
+    _array.store(tmp, std::memory_order_release);
+    a = tmp;
+  }
+
+  for(size_t i=0; i<N; ++i, ++first) {
+    a->push(b + static_cast<int64_t>(i), *first);
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // original paper uses relaxed here but tsa complains
+  _bottom.store(b + static_cast<int64_t>(N), std::memory_order_release);
+}
+
 // Function: pop
 template <typename T>
 T UnboundedTaskQueue<T>::pop() {
@@ -420,6 +508,39 @@ class BoundedTaskQueue {
   */
   template <typename O, typename C>
   void push(O&& item, C&& on_full);
+
+  /**
+  @brief tries to insert a batch of items to the queue
+
+  @tparam I input iterator type whose value is convertible to @c T
+  @param first iterator to the first item
+  @param N number of items to insert
+  @return the number of items inserted, which is less than @c N if the
+          queue does not have room for all of them
+
+  Only the owner thread can insert items to the queue.
+  The inserted items become visible to thieves together through a single
+  store to the bottom index.
+  */
+  template <typename I>
+  size_t try_bulk_push(I& first, size_t N);
+
+  /**
+  @brief inserts a batch of items to the queue or invokes the callable
+         on the items that do not fit
+
+  @tparam I input iterator type whose value is convertible to @c T
+  @tparam C callable type
+  @param first iterator to the first item
+  @param N number of items to insert
+  @param on_full callable invoked as <tt>on_full(it, n)</tt> with an
+                 iterator to the first of the @c n items that did not fit
+
+  Only the owner thread can insert items to the queue.
+  Items that fit are published with a single store to the bottom index.
+  */
+  template <typename I, typename C>
+  void bulk_push(I first, size_t N, C&& on_full);
   
   /**
   @brief pops out an item from the queue
@@ -511,6 +632,41 @@ void BoundedTaskQueue<T, LogSize>::push(O&& o, C&& on_full) {
   _bottom.store(b + 1, std::memory_order_release);
 }
 
+// Function: try_bulk_push
+template <typename T, size_t LogSize>
+template <typename I>
+size_t BoundedTaskQueue<T, LogSize>::try_bulk_push(I& first, size_t N) {
+
+  int64_t b = _bottom.load(std::memory_order_relaxed);
+  int64_t t = _top.load(std::memory_order_acquire);
+
+  size_t n = std::min(N, static_cast<size_t>(std::max(int64_t{0}, BufferSize - (b - t))));
+
+  if(n == 0) {
+    return 0;
+  }
+
+  for(size_t i=0; i<n; ++i, ++first) {
+    _buffer[(b + static_cast<int64_t>(i)) & BufferMask].store(*first, std::memory_order_relaxed);
+  }
+
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // original paper uses relaxed here but tsa complains
+  _bottom.store(b + static_cast<int64_t>(n), std::memory_order_release);
+
+  return n;
+}
+
+// Function: bulk_push
+template <typename T, size_t LogSize>
+template <typename I, typename C>
+void BoundedTaskQueue<T, LogSize>::bulk_push(I first, size_t N, C&& on_full) {
+  if(size_t n = try_bulk_push(first, N); n < N) {
+    on_full(first, N - n);
+  }
+}
+
 // Function: pop
 template <typename T, size_t LogSize>
 T BoundedTaskQueue<T, LogSize>::pop() {
@@ -592,6 +748,171 @@ constexpr size_t BoundedTaskQueue<T, LogSize>::capacity() const {
   return static_cast<size_t>(BufferSize);
 }
 
+// ----------------------------------------------------------------------------
+// Prioritized Work-stealing Queue
+// ----------------------------------------------------------------------------
+
+/**
+@class PriorityTaskQueue
+
+@tparam T data type (must be a pointer type)
+@tparam P number of priority lanes
+@tparam LogSize the base-2 logarithm of the capacity of each lane
+
+@brief class to create a work-stealing queue with one bounded lane per priority
+
+Lane @c 0 has the highest priority.
+Both tf::PriorityTaskQueue::pop and tf::PriorityTaskQueue::steal take from
+the highest-priority non-empty lane, except that one in every
+TF_TASK_PRIORITY_AGING pops, and every aged steal, scans the lanes from the
+lowest priority up to keep lower-priority items from starving.
+*/
+template <typename T, size_t P = static_cast<size_t>(TaskPriority::MAX),
+          size_t LogSize = TF_DEFAULT_BOUNDED_TASK_QUEUE_LOG_SIZE>
+class PriorityTaskQueue {
+
+  static_assert(P >= 1, "a prioritized queue needs at least one lane");
+
+  BoundedTaskQueue<T, LogSize> _lanes[P];
+
+  // touched by the owner thread only
+  size_t _num_pops {0};
+
+  public:
+
+  /**
+  @brief queries if all lanes are empty at the time of this call
+  */
+  bool empty() const noexcept;
+
+  /**
+  @brief queries the number of items in all lanes at the time of this call
+  */
+  size_t size() const noexcept;
+
+  /**
+  @brief queries the capacity of all lanes together
+  */
+  constexpr size_t capacity() const;
+
+  /**
+  @brief inserts an item to the lane of priority @c p or invokes the callable
+         if that lane is full
+
+  Only the owner thread can insert an item to the queue.
+  */
+  template <typename O, typename C>
+  void push(O&& item, size_t p, C&& on_full);
+
+  /**
+  @brief inserts a batch of items to the lane of priority @c p or invokes the
+         callable on the items that do not fit (see
+         tf::BoundedTaskQueue::bulk_push)
+
+  Only the owner thread can insert items to the queue.
+  */
+  template <typename I, typename C>
+  void bulk_push(I first, size_t N, size_t p, C&& on_full);
+
+  /**
+  @brief pops out an item from the highest-priority non-empty lane
+
+  Only the owner thread can pop out an item from the queue.
+  The return can be a `nullptr` if this operation failed (empty queue).
+  */
+  T pop();
+
+  /**
+  @brief steals an item from the highest-priority non-empty lane, or from the
+         lowest-priority non-empty lane if @c aged is true
+
+  Any threads can try to steal an item from the queue.
+  The return can be a `nullptr` if this operation failed (not necessary empty).
+  */
+  T steal(bool aged = false);
+};
+
+// Function: empty
+template <typename T, size_t P, size_t LogSize>
+bool PriorityTaskQueue<T, P, LogSize>::empty() const noexcept {
+  for(size_t p=0; p<P; ++p) {
+    if(!_lanes[p].empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Function: size
+template <typename T, size_t P, size_t LogSize>
+size_t PriorityTaskQueue<T, P, LogSize>::size() const noexcept {
+  size_t n = 0;
+  for(size_t p=0; p<P; ++p) {
+    n += _lanes[p].size();
+  }
+  return n;
+}
+
+// Function: capacity
+template <typename T, size_t P, size_t LogSize>
+constexpr size_t PriorityTaskQueue<T, P, LogSize>::capacity() const {
+  return P * _lanes[0].capacity();
+}
+
+// Procedure: push
+template <typename T, size_t P, size_t LogSize>
+template <typename O, typename C>
+void PriorityTaskQueue<T, P, LogSize>::push(O&& item, size_t p, C&& on_full) {
+  _lanes[p].push(std::forward<O>(item), std::forward<C>(on_full));
+}
+
+// Procedure: bulk_push
+template <typename T, size_t P, size_t LogSize>
+template <typename I, typename C>
+void PriorityTaskQueue<T, P, LogSize>::bulk_push(I first, size_t N, size_t p, C&& on_full) {
+  _lanes[p].bulk_push(first, N, std::forward<C>(on_full));
+}
+
+// Function: pop
+// The owner reads its own lanes' bottom indices, so an empty lane is skipped
+// without paying for the fence in BoundedTaskQueue::pop.
+template <typename T, size_t P, size_t LogSize>
+T PriorityTaskQueue<T, P, LogSize>::pop() {
+  if(++_num_pops % TF_TASK_PRIORITY_AGING == 0) {
+    for(size_t p=P; p-- > 0;) {
+      if(!_lanes[p].empty()) {
+        if(auto item = _lanes[p].pop(); item) {
+          return item;
+        }
+      }
+    }
+  }
+  else {
+    for(size_t p=0; p<P; ++p) {
+      if(!_lanes[p].empty()) {
+        if(auto item = _lanes[p].pop(); item) {
+          return item;
+        }
+      }
+    }
+  }
+  return nullptr;
+}
+
+// Function: steal
+template <typename T, size_t P, size_t LogSize>
+T PriorityTaskQueue<T, P, LogSize>::steal(bool aged) {
+  for(size_t i=0; i<P; ++i) {
+    auto& lane = _lanes[aged ? P-1-i : i];
+    if(!lane.empty()) {
+      if(auto item = lane.steal(); item) {
+        return item;
+      }
+    }
+  }
+  return nullptr;
+}
+
 
 
 //-----------------------------------------------------------------------------
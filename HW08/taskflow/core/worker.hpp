@@ -4,6 +4,8 @@
 #include "tsq.hpp"
 #include "atomic_notifier.hpp"
 #include "nonblocking_notifier.hpp"
+#include "idle_policy.hpp"
+#include "metrics.hpp"
 
 
 /**
@@ -82,6 +84,52 @@ class Worker {
     */
     inline Executor* executor() { return _executor; }
 
+    /**
+    @brief queries the id of the NUMA node this worker is placed on
+
+    The id is the operating-system node id from tf::NumaTopology,
+    or @c 0 for an executor constructed without a NUMA topology.
+    */
+    inline size_t numa_node() const { return _numa_node; }
+
+    /**
+    @brief queries the CPUs this worker is bound to
+
+    The vector is empty for an executor constructed without a NUMA
+    topology, and when binding the worker thread failed (e.g., none of its
+    CPUs is in the cpuset of the process).
+    */
+    inline const std::vector<int>& cpus() const { return _cpus; }
+
+    /**
+    @brief queries the queues this worker steals from, nearest first
+
+    Entries below the number of workers are worker ids; the others are the
+    executor's shared buffers.
+    The first num_cluster_victims() entries share this worker's cluster and
+    the first num_domain_victims() its NUMA domain.
+    An executor constructed without a NUMA topology has a single tier
+    over all queues.
+    */
+    inline const std::vector<size_t>& victims() const { return _victims; }
+
+    /**
+    @brief queries the number of victims that share this worker's cluster
+    */
+    inline size_t num_cluster_victims() const { return _victim_tiers[0]; }
+
+    /**
+    @brief queries the number of victims that share this worker's NUMA domain,
+           including those of its cluster
+    */
+    inline size_t num_domain_victims() const { return _victim_tiers[1]; }
+
+    /**
+    @brief queries the time this worker has spent idle in each phase of
+           the executor's tf::IdlePolicy
+    */
+    inline IdleStats idle_stats() const { return _idle_counters.load(); }
+
     /**
     @brief acquires the associated thread
     */
@@ -97,6 +145,8 @@ class Worker {
 
     size_t _id;
     size_t _vtm;
+    size_t _domain {0};
+    size_t _numa_node {0};
     Executor* _executor {nullptr};
     DefaultNotifier::Waiter* _waiter;
     std::thread _thread;
@@ -104,7 +154,34 @@ class Worker {
     std::default_random_engine _rdgen;
     //std::uniform_int_distribution<size_t> _udist;
 
-    BoundedTaskQueue<Node*> _wsq;
+    // one lane per tf::TaskPriority
+    PriorityTaskQueue<Node*> _wsq;
+
+    // local pops and steal attempts, used to age the buffers and the
+    // lower-priority lanes (see Executor::_serve_buffers and Executor::_steal)
+    size_t _num_pops {0};
+    size_t _num_steal_attempts {0};
+
+    // steal victims (queue ids) ordered by locality: [0, _victim_tiers[0])
+    // share this worker's cluster, [.., _victim_tiers[1]) its NUMA domain
+    std::vector<size_t> _victims;
+    size_t _victim_tiers[2] {0, 0};
+
+    // CPUs the worker thread is bound to (empty if unbound)
+    std::vector<int> _cpus;
+
+    // this worker's copy of the executor's idle policy, refreshed when the
+    // executor's policy epoch moves, and the adaptive steal success rate
+    // as an exponential moving average in [0, 1024]
+    IdlePolicy _idle_policy;
+    size_t _idle_epoch {0};
+    size_t _steal_rate {512};
+    IdleCounters _idle_counters;
+
+    // set when the worker wakes up from a sleep, cleared once it either
+    // finds a task (a wake-up) or sleeps again
+    bool _woken {false};
+    MetricsCounters _metrics;
 
     //TF_FORCE_INLINE size_t _rdvtm() {
     //  auto r = _udist(_rdgen);
@@ -167,6 +244,12 @@ class WorkerView {
     */
     size_t queue_capacity() const;
 
+    /**
+    @brief queries the time the worker has spent idle in each phase of
+           the executor's tf::IdlePolicy
+    */
+    IdleStats idle_stats() const;
+
   private:
 
     WorkerView(const Worker&);
@@ -195,6 +278,11 @@ inline size_t WorkerView::queue_capacity() const {
   return static_cast<size_t>(_worker._wsq.capacity());
 }
 
+// Function: idle_stats
+inline IdleStats WorkerView::idle_stats() const {
+  return _worker.idle_stats();
+}
+
 // ----------------------------------------------------------------------------
 // Class Definition: WorkerInterface
 // ----------------------------------------------------------------------------
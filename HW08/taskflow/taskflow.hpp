@@ -6,6 +6,10 @@
 // + TF_ENABLE_TASK_POOL       : enable task pool optimization
 // + TF_ENABLE_ATOMIC_NOTIFIER : enable atomic notifier (required C++20)
 //
+// Enabled features by default:
+// + node arena for async tasks (define TF_DISABLE_NODE_ARENA to allocate
+//   them with new/delete or the task pool instead)
+//
 
 #include "core/executor.hpp"
 #include "core/runtime.hpp"
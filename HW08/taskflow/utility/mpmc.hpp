@@ -133,6 +133,12 @@ public:
     return beg >= end;
   }
 
+  size_t size() const {
+    auto beg = _dequeue_pos.load(std::memory_order_relaxed);
+    auto end = _enqueue_pos.load(std::memory_order_relaxed);
+    return end > beg ? static_cast<size_t>(end - beg) : 0;
+  }
+
   size_t capacity() const {
     return BufferSize;
   }
@@ -273,6 +279,12 @@ public:
     return beg >= end;
   }
 
+  size_t size() const {
+    auto beg = _dequeue_pos.load(std::memory_order_relaxed);
+    auto end = _enqueue_pos.load(std::memory_order_relaxed);
+    return end > beg ? static_cast<size_t>(end - beg) : 0;
+  }
+
   size_t capacity() const {
     return BufferSize;
   }
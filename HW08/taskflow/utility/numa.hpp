@@ -0,0 +1,314 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "os.hpp"
+
+#if TF_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/**
+@file numa.hpp
+@brief NUMA topology include file
+*/
+
+namespace tf {
+
+// ----------------------------------------------------------------------------
+// NumaNode
+// ----------------------------------------------------------------------------
+
+/**
+@struct NumaNode
+
+@brief struct to describe the CPUs of one NUMA node
+
+CPUs are stored grouped by cluster (CPUs sharing the last-level cache),
+so consecutive entries of @c cpus are as close to each other as the
+hardware allows.
+*/
+struct NumaNode {
+
+  /**
+  @brief node id as reported by the operating system
+  */
+  size_t id {0};
+
+  /**
+  @brief CPUs of this node, grouped by cluster
+  */
+  std::vector<int> cpus;
+
+  /**
+  @brief cluster index of each entry in @c cpus, local to this node
+  */
+  std::vector<size_t> clusters;
+};
+
+// ----------------------------------------------------------------------------
+// NumaTopology
+// ----------------------------------------------------------------------------
+
+/**
+@class NumaTopology
+
+@brief class to discover the NUMA nodes and CPU clusters of the machine
+
+A default-constructed topology has a single node holding the CPUs the
+process may run on (see NumaTopology::allowed_cpus) in one cluster.
+NumaTopology::discover reads the layout from Linux sysfs
+(<tt>/sys/devices/system/node</tt> for nodes and the last-level cache of
+<tt>/sys/devices/system/cpu</tt> for clusters) and falls back to the
+default topology on other platforms.
+Both keep only the CPUs in the affinity mask of the process, so an
+executor started inside a restricted cpuset (e.g., a SLURM allocation)
+places its workers on CPUs it is allowed to use.
+
+@code{.cpp}
+tf::NumaTopology numa = tf::NumaTopology::discover();
+tf::Executor executor(numa.num_cpus(), numa);
+@endcode
+*/
+class NumaTopology {
+
+  public:
+
+  /**
+  @brief constructs a single-node topology over all hardware threads
+  */
+  NumaTopology() {
+    NumaNode node;
+    node.cpus = allowed_cpus();
+    if(node.cpus.empty()) {
+      size_t n = std::max(1u, std::thread::hardware_concurrency());
+      for(size_t c=0; c<n; ++c) {
+        node.cpus.push_back(static_cast<int>(c));
+      }
+    }
+    node.clusters.resize(node.cpus.size(), 0);
+    _nodes.push_back(std::move(node));
+  }
+
+  /**
+  @brief discovers the topology of this machine
+
+  @param sysfs root of the sysfs system directory (overridable for testing)
+  @param allowed CPUs to keep, or all CPUs if empty
+                 (defaults to the affinity mask of the process)
+
+  Nodes without allowed CPUs (e.g., memory-only nodes or nodes outside the
+  cpuset of the process) are skipped.
+  If nothing can be read, the default single-node topology is returned.
+  */
+  static NumaTopology discover(
+    const std::string& sysfs = "/sys/devices/system",
+    const std::vector<int>& allowed = allowed_cpus()
+  );
+
+  /**
+  @brief queries the CPUs in the affinity mask of the calling process,
+         or an empty vector if unknown
+  */
+  static std::vector<int> allowed_cpus();
+
+  /**
+  @brief queries the number of NUMA nodes with at least one CPU
+  */
+  size_t num_nodes() const { return _nodes.size(); }
+
+  /**
+  @brief queries the total number of CPUs over all nodes
+  */
+  size_t num_cpus() const {
+    size_t n = 0;
+    for(auto& node : _nodes) {
+      n += node.cpus.size();
+    }
+    return n;
+  }
+
+  /**
+  @brief acquires the nodes of this topology
+  */
+  const std::vector<NumaNode>& nodes() const { return _nodes; }
+
+  /**
+  @brief parses a sysfs CPU list such as <tt>0-3,8-11</tt>
+  */
+  static std::vector<int> parse_cpu_list(const std::string& str);
+
+  /**
+  @brief queries the CPU the calling thread is running on, or @c -1 if unknown
+  */
+  static int current_cpu() {
+  #if TF_OS_LINUX
+    return sched_getcpu();
+  #else
+    return -1;
+  #endif
+  }
+
+  /**
+  @brief restricts the calling thread to the given CPUs
+
+  @return @c true if the affinity was applied
+  */
+  static bool bind_this_thread(const std::vector<int>& cpus);
+
+  private:
+
+  std::vector<NumaNode> _nodes;
+
+  static std::string _read_line(const std::string& path) {
+    std::ifstream ifs(path);
+    std::string line;
+    std::getline(ifs, line);
+    return line;
+  }
+};
+
+// Function: parse_cpu_list
+inline std::vector<int> NumaTopology::parse_cpu_list(const std::string& str) {
+  std::vector<int> cpus;
+  size_t i = 0;
+  auto number = [&](int& v) {
+    size_t beg = i;
+    v = 0;
+    while(i < str.size() && str[i] >= '0' && str[i] <= '9') {
+      v = v * 10 + (str[i++] - '0');
+    }
+    return i > beg;
+  };
+  while(i < str.size()) {
+    int lo, hi;
+    if(!number(lo)) {
+      ++i;
+      continue;
+    }
+    hi = lo;
+    if(i < str.size() && str[i] == '-') {
+      ++i;
+      if(!number(hi)) {
+        hi = lo;
+      }
+    }
+    for(int c=lo; c<=hi; ++c) {
+      cpus.push_back(c);
+    }
+  }
+  return cpus;
+}
+
+// Function: discover
+inline NumaTopology NumaTopology::discover(
+  const std::string& sysfs, const std::vector<int>& allowed
+) {
+
+  NumaTopology topo;
+  std::vector<NumaNode> nodes;
+
+  auto possible = parse_cpu_list(_read_line(sysfs + "/node/possible"));
+
+  for(int id : possible) {
+    auto cpus = parse_cpu_list(
+      _read_line(sysfs + "/node/node" + std::to_string(id) + "/cpulist")
+    );
+    if(!allowed.empty()) {
+      cpus.erase(std::remove_if(cpus.begin(), cpus.end(), [&](int c){
+        return std::find(allowed.begin(), allowed.end(), c) == allowed.end();
+      }), cpus.end());
+    }
+    if(cpus.empty()) {
+      continue;
+    }
+
+    // a cluster is the set of CPUs sharing the last-level cache; fall back
+    // to the kernel's cluster_cpus_list and then to the whole node
+    std::vector<std::string> keys(cpus.size());
+    for(size_t i=0; i<cpus.size(); ++i) {
+      auto dir = sysfs + "/cpu/cpu" + std::to_string(cpus[i]);
+      int best = -1;
+      for(size_t idx=0; ; ++idx) {
+        auto cache = dir + "/cache/index" + std::to_string(idx);
+        auto level = _read_line(cache + "/level");
+        if(level.empty()) {
+          break;
+        }
+        if(int l = std::atoi(level.c_str()); l > best) {
+          best = l;
+          keys[i] = _read_line(cache + "/shared_cpu_list");
+        }
+      }
+      if(keys[i].empty()) {
+        keys[i] = _read_line(dir + "/topology/cluster_cpus_list");
+      }
+    }
+
+    // group CPUs by cluster in order of first appearance
+    NumaNode node;
+    node.id = static_cast<size_t>(id);
+    std::vector<std::string> seen;
+    for(size_t i=0; i<cpus.size(); ++i) {
+      if(std::find(seen.begin(), seen.end(), keys[i]) != seen.end()) {
+        continue;
+      }
+      for(size_t j=i; j<cpus.size(); ++j) {
+        if(keys[j] == keys[i]) {
+          node.cpus.push_back(cpus[j]);
+          node.clusters.push_back(seen.size());
+        }
+      }
+      seen.push_back(keys[i]);
+    }
+    nodes.push_back(std::move(node));
+  }
+
+  if(!nodes.empty()) {
+    topo._nodes = std::move(nodes);
+  }
+
+  return topo;
+}
+
+// Function: allowed_cpus
+inline std::vector<int> NumaTopology::allowed_cpus() {
+  std::vector<int> cpus;
+#if TF_OS_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if(sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for(int c=0; c<CPU_SETSIZE; ++c) {
+      if(CPU_ISSET(c, &set)) {
+        cpus.push_back(c);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+// Function: bind_this_thread
+inline bool NumaTopology::bind_this_thread(const std::vector<int>& cpus) {
+#if TF_OS_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for(int c : cpus) {
+    if(c >= 0 && c < CPU_SETSIZE) {
+      CPU_SET(c, &set);
+    }
+  }
+  return CPU_COUNT(&set) > 0 &&
+         pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+}  // end of namespace tf -----------------------------------------------------
@@ -33,7 +33,7 @@ namespace tf {
 // only one object at a time.
 //
 // Internally, we use the following variables to maintain blocks and heaps:
-// X: size in byte of a item slot
+// X: size in byte of a item slot (a multiple of alignof(T))
 // M: number of items per block
 // F: emptiness threshold
 // B: number of bins per local heap (bin[B-1] is the full list)
@@ -64,8 +64,10 @@ namespace tf {
 template <typename T, size_t S = 65536>
 class ObjectPool {
 
-  // the data column must be sufficient to hold the pointer in freelist
-  constexpr static size_t X = (std::max)(sizeof(T*), sizeof(T));
+  // the data column must be sufficient to hold the pointer in freelist,
+  // and every slot must start at a multiple of alignof(T)
+  constexpr static size_t A = (std::max)(alignof(T*), alignof(T));
+  constexpr static size_t X = ((std::max)(sizeof(T*), sizeof(T)) + A - 1) / A * A;
   //constexpr static size_t X = sizeof(long double) + std::max(sizeof(T*), sizeof(T));
   //constexpr static size_t M = (S - offsetof(Block, data)) / X;
   constexpr static size_t M = S / X;
@@ -106,9 +108,15 @@ class ObjectPool {
     size_t u;
     T* top;
     // long double padding;
-    char data[S];
+    // over-aligned T pads the header; new Block() honors alignof(Block)
+    alignas(A) char data[S];
   };
 
+  static_assert(
+    offsetof(Block, data) % A == 0 && alignof(Block) >= A,
+    "object slots must be aligned to alignof(T)"
+  );
+
   public:
 
     /**
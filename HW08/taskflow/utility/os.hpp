@@ -1,10 +1,16 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <cstdio>
 #include <string>
 #include <thread>
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
 #define TF_OS_LINUX 0
 #define TF_OS_DRAGONFLY 0
 #define TF_OS_FREEBSD 0
@@ -255,6 +261,42 @@ inline void pause(size_t count) {
   while(count-- > 0) pause();
 }
 
+/**
+ * @brief reads a cheap, monotonically increasing timestamp counter
+ *
+ * On x86 this function reads the time-stamp counter with @c rdtsc, and on
+ * AArch64 the virtual counter @c cntvct_el0; both take a few nanoseconds and
+ * do not enter the kernel. On other architectures it falls back to
+ * @c std::chrono::steady_clock in nanoseconds.
+ * The unit of the counter is unspecified; callers convert ticks to time by
+ * pairing two readings with two @c steady_clock readings.
+ *
+ * @attention On x86 the counter is only comparable across cores on CPUs with
+ * an invariant, synchronized TSC, which holds for current Intel and AMD
+ * processors.
+ */
+inline uint64_t read_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+  #if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ia32_rdtsc();
+  #else
+    return __rdtsc();
+  #endif
+#elif defined(_M_X64) || defined(_M_IX86)
+  return __rdtsc();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+  uint64_t t;
+  asm volatile("mrs %0, cntvct_el0" : "=r"(t));
+  return t;
+#else
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()
+    ).count()
+  );
+#endif
+}
+
 /**
  * @brief spins until the given predicate becomes true
  * 
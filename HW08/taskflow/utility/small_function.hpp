@@ -0,0 +1,214 @@
+#pragma once
+
+#include "macros.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+@file small_function.hpp
+@brief small function include file
+*/
+
+#ifndef TF_DEFAULT_SMALL_FUNCTION_INLINE_SIZE
+  /**
+  @def TF_DEFAULT_SMALL_FUNCTION_INLINE_SIZE
+
+  This macro defines the default number of bytes a tf::SmallFunction stores
+  inline. With the two function pointers of its dispatch, the default of
+  40 makes the whole object 56 bytes, which keeps a tf::Node within
+  three cache lines. Callables that are bigger, aligned beyond a pointer
+  or not nothrow-movable are allocated on the heap.
+  */
+  #define TF_DEFAULT_SMALL_FUNCTION_INLINE_SIZE 40
+#endif
+
+namespace tf {
+
+/**
+@private
+*/
+template <typename Sig, size_t N = TF_DEFAULT_SMALL_FUNCTION_INLINE_SIZE>
+class SmallFunction;
+
+/**
+@class SmallFunction
+
+@brief class to create a move-only, type-erased callable with inline storage
+
+@tparam R return type
+@tparam Args argument types
+@tparam N number of bytes of inline storage
+
+Unlike std::function, a tf::SmallFunction stores any nothrow-movable callable
+of up to @c N bytes in place, with no heap allocation, and accepts move-only
+callables such as lambdas capturing a std::promise or a std::unique_ptr.
+The object cannot be copied.
+Invoking an empty tf::SmallFunction is undefined.
+
+@code{.cpp}
+std::promise<int> p;
+tf::SmallFunction<void()> f = [p=std::move(p)]() mutable { p.set_value(1); };
+f();
+@endcode
+*/
+template <typename R, typename... Args, size_t N>
+class SmallFunction<R(Args...), N> {
+
+  static_assert(N >= sizeof(void*), "inline storage must hold a pointer");
+
+  enum class Op { MOVE, DESTROY };
+
+  using invoke_t = R(*)(void*, Args&&...);
+  using manage_t = void(*)(Op, void*, void*);
+
+  template <typename F>
+  constexpr static bool is_inline_v =
+    sizeof(F) <= N &&
+    alignof(F) <= alignof(void*) &&
+    std::is_nothrow_move_constructible_v<F>;
+
+  public:
+
+  /**
+  @brief constructs an empty small function
+  */
+  SmallFunction() noexcept = default;
+
+  /**
+  @brief constructs an empty small function
+  */
+  SmallFunction(std::nullptr_t) noexcept {}
+
+  /**
+  @brief constructs a small function that owns the given callable
+  */
+  template <typename F, std::enable_if_t<
+    !std::is_same_v<std::decay_t<F>, SmallFunction> &&
+    std::is_invocable_r_v<R, std::decay_t<F>&, Args...>, void>* = nullptr
+  >
+  SmallFunction(F&& f) {
+    _emplace<std::decay_t<F>>(std::forward<F>(f));
+  }
+
+  /**
+  @brief move-constructs a small function, leaving @c rhs empty
+  */
+  SmallFunction(SmallFunction&& rhs) noexcept {
+    _steal(rhs);
+  }
+
+  /**
+  @brief move-assigns a small function, leaving @c rhs empty
+  */
+  SmallFunction& operator = (SmallFunction&& rhs) noexcept {
+    if(this != &rhs) {
+      _reset();
+      _steal(rhs);
+    }
+    return *this;
+  }
+
+  /**
+  @brief destroys the owned callable and leaves the function empty
+  */
+  SmallFunction& operator = (std::nullptr_t) noexcept {
+    _reset();
+    return *this;
+  }
+
+  SmallFunction(const SmallFunction&) = delete;
+  SmallFunction& operator = (const SmallFunction&) = delete;
+
+  /**
+  @brief destructs the small function and the callable it owns
+  */
+  ~SmallFunction() {
+    _reset();
+  }
+
+  /**
+  @brief queries if the small function owns a callable
+  */
+  explicit operator bool() const noexcept {
+    return _invoke != nullptr;
+  }
+
+  /**
+  @brief invokes the owned callable
+  */
+  R operator () (Args... args) {
+    return _invoke(_storage, std::forward<Args>(args)...);
+  }
+
+  /**
+  @brief queries if a callable of type @c F is stored inline
+  */
+  template <typename F>
+  constexpr static bool stores_inline() {
+    return is_inline_v<std::decay_t<F>>;
+  }
+
+  private:
+
+  invoke_t _invoke {nullptr};
+  manage_t _manage {nullptr};
+
+  alignas(void*) unsigned char _storage[N];
+
+  template <typename F, typename C>
+  void _emplace(C&& c) {
+    if constexpr (is_inline_v<F>) {
+      ::new (static_cast<void*>(_storage)) F(std::forward<C>(c));
+      _invoke = [](void* s, Args&&... args) -> R {
+        return std::invoke(*std::launder(static_cast<F*>(s)), std::forward<Args>(args)...);
+      };
+      _manage = [](Op op, void* src, void* dst) {
+        auto f = std::launder(static_cast<F*>(src));
+        if(op == Op::MOVE) {
+          ::new (dst) F(std::move(*f));
+        }
+        f->~F();
+      };
+    }
+    else {
+      ::new (static_cast<void*>(_storage)) F*(new F(std::forward<C>(c)));
+      _invoke = [](void* s, Args&&... args) -> R {
+        return std::invoke(**std::launder(static_cast<F**>(s)), std::forward<Args>(args)...);
+      };
+      // the heap object stays where it is; moving only hands over the pointer
+      _manage = [](Op op, void* src, void* dst) {
+        auto f = *std::launder(static_cast<F**>(src));
+        if(op == Op::MOVE) {
+          ::new (dst) F*(f);
+        }
+        else {
+          delete f;
+        }
+      };
+    }
+  }
+
+  void _steal(SmallFunction& rhs) noexcept {
+    if(rhs._invoke) {
+      rhs._manage(Op::MOVE, rhs._storage, _storage);
+      _invoke = rhs._invoke;
+      _manage = rhs._manage;
+      rhs._invoke = nullptr;
+      rhs._manage = nullptr;
+    }
+  }
+
+  void _reset() noexcept {
+    if(_invoke) {
+      _manage(Op::DESTROY, _storage, nullptr);
+      _invoke = nullptr;
+      _manage = nullptr;
+    }
+  }
+};
+
+}  // end of namespace tf -----------------------------------------------------